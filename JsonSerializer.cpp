@@ -0,0 +1,11 @@
+// File: JsonSerializer
+// Author: linxmouse@gmail.com
+// Creation: 2024/09/29
+//
+// 常用序列化器的显式实例化定义，与 JsonSerializer.h 中的 extern template 声明对应
+#define JSON_SERIALIZER_INSTANTIATE
+#include "JsonSerializer.h"
+
+// 元素引用为代理对象的容器也能覆盖解码与原地应用补丁
+template struct JsonAssignSequence<std::vector<bool>>;
+template struct JsonPatchSequence<std::vector<bool>>;
@@ -8,13 +8,23 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonValue>
+#include <QLocale>
 #include <type_traits>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <atomic>
+#include <functional>
 
 /* META OBJECT SYSTEM */
 #include <QVariant>
 #include <QMetaProperty>
 #include <QMetaObject>
 #include <QMetaType>
+#include <QUuid>
+#include <QMutex>
+#include <QVarLengthArray>
 
 /* CONTAINER TYPE */
 #include <QVector>
@@ -23,6 +33,14 @@
 #include <QHash>
 #include <vector>
 #include <map>
+#include <tuple>
+#include <array>
+#include <utility>
+
+/* SMART POINTER */
+#include <QSharedPointer>
+#include <memory>
+#include <typeinfo>
 
 /**
  * @brief 通用序列化器模板
@@ -36,6 +54,18 @@
 template <typename T, typename Enable = void>
 struct Serializer;
 
+/**
+ * @brief 生成的序列化代码模板
+ * @tparam T 可序列化类
+ * @details
+ * 由 JsonSerializerGen 根据头文件中的 JSON_PROPERTY 声明生成特化版本，
+ * 通过公开的 ref_xxx()/set_xxx() 访问成员，以固定的键分派完成编解码
+ * 特化只出现在生成的源文件中，由 JSON_REGISTER_GENERATED 在静态初始化时登记到 T 的属性表，
+ * 其他翻译单元看到的类型与 Serializer<T> 保持不变
+ */
+template <typename T>
+struct JsonGeneratedCodec;
+
 /**
  * @brief JSON 值转换器的基本模板
  * @tparam T 待转换的数据类型
@@ -87,6 +117,317 @@ struct Serializer<QJsonValue>
 	}
 };
 
+/**
+ * @brief 浮点数输出精度策略
+ * @details
+ * 按固定小数位数或有效数字位数对浮点数取整后再输出
+ * 取整采用整数缩放（乘以 10 的幂后四舍五入为整数再缩放回去），不经过字符串格式化
+ * QJsonDocument 以最短可还原形式输出 double，取整后的值只会输出所需的位数
+ * 全局策略通过 setGlobal() 设置，JsonFloatPrecisionScope 可在当前线程内临时覆盖
+ */
+class JsonFloatPrecision
+{
+public:
+	enum Mode
+	{
+		Full,              ///< 完整精度（默认）
+		Decimals,          ///< 固定小数位数
+		SignificantDigits  ///< 固定有效数字位数
+	};
+
+	constexpr JsonFloatPrecision(Mode mode = Full, int digits = 0)
+		: m_mode(mode), m_digits(digits)
+	{
+	}
+
+	static constexpr JsonFloatPrecision full()
+	{
+		return JsonFloatPrecision(Full);
+	}
+
+	static constexpr JsonFloatPrecision decimals(int digits)
+	{
+		return JsonFloatPrecision(Decimals, digits);
+	}
+
+	static constexpr JsonFloatPrecision significantDigits(int digits)
+	{
+		return JsonFloatPrecision(SignificantDigits, digits);
+	}
+
+	Mode mode() const
+	{
+		return m_mode;
+	}
+
+	int digits() const
+	{
+		return m_digits;
+	}
+
+	bool operator==(const JsonFloatPrecision &other) const
+	{
+		return m_mode == other.m_mode && (m_mode == Full || m_digits == other.m_digits);
+	}
+
+	bool operator!=(const JsonFloatPrecision &other) const
+	{
+		return !(*this == other);
+	}
+
+	/**
+	 * @brief 按策略对浮点数取整
+	 * @param value 原始值
+	 * @return double 取整后的值；非有限值及超出 2^53 缩放范围的值原样返回
+	 */
+	double apply(double value) const
+	{
+		if (m_mode == Full || value == 0 || !std::isfinite(value))
+		{
+			return value;
+		}
+		int decimals = m_digits;
+		if (m_mode == SignificantDigits)
+		{
+			decimals = m_digits - 1 - static_cast<int>(std::floor(std::log10(std::fabs(value))));
+		}
+		if (decimals >= 0)
+		{
+			if (decimals > MaxExponent)
+			{
+				return value;
+			}
+			double scaled = value * power10(decimals);
+			return std::fabs(scaled) < MaxExact ? static_cast<double>(std::llround(scaled)) / power10(decimals) : value;
+		}
+		if (-decimals > MaxExponent)
+		{
+			return value;
+		}
+		double scaled = value / power10(-decimals);
+		return static_cast<double>(std::llround(scaled)) * power10(-decimals);
+	}
+
+	/**
+	 * @brief 当前线程生效的策略
+	 * @return JsonFloatPrecision 作用域内的覆盖策略，没有则为全局策略
+	 */
+	static JsonFloatPrecision current()
+	{
+		const JsonFloatPrecision *scoped = scopedPolicy();
+		return scoped ? *scoped : globalPolicy();
+	}
+
+	/**
+	 * @brief 设置全局策略
+	 * @details 应在开始序列化之前设置，运行中修改不保证对其他线程立即可见
+	 * @param policy 新的全局策略
+	 */
+	static void setGlobal(const JsonFloatPrecision &policy)
+	{
+		globalPolicy() = policy;
+	}
+
+private:
+	friend class JsonFloatPrecisionScope;
+
+	static constexpr int MaxExponent = 22;
+	static constexpr double MaxExact = 9007199254740992.0;
+
+	static double power10(int exponent)
+	{
+		static const double table[MaxExponent + 1] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+		return table[exponent];
+	}
+
+	static JsonFloatPrecision &globalPolicy()
+	{
+		static JsonFloatPrecision policy;
+		return policy;
+	}
+
+	static const JsonFloatPrecision *&scopedPolicy()
+	{
+		static thread_local const JsonFloatPrecision *policy = nullptr;
+		return policy;
+	}
+
+	Mode m_mode;
+	int m_digits;
+};
+
+/**
+ * @brief 在当前线程内临时覆盖浮点数输出精度的作用域
+ */
+class JsonFloatPrecisionScope
+{
+public:
+	explicit JsonFloatPrecisionScope(const JsonFloatPrecision &policy)
+		: m_policy(policy), m_previous(JsonFloatPrecision::scopedPolicy())
+	{
+		JsonFloatPrecision::scopedPolicy() = &m_policy;
+	}
+
+	~JsonFloatPrecisionScope()
+	{
+		JsonFloatPrecision::scopedPolicy() = m_previous;
+	}
+
+	JsonFloatPrecisionScope(const JsonFloatPrecisionScope &) = delete;
+	JsonFloatPrecisionScope &operator=(const JsonFloatPrecisionScope &) = delete;
+
+private:
+	JsonFloatPrecision m_policy;
+	const JsonFloatPrecision *m_previous;
+};
+
+/**
+ * @brief 数值类型与 QJsonValue 之间的直接转换
+ * @tparam T 数值类型
+ * @details
+ * 数值直接构造 QJsonValue 或从中读取，不经过 QVariant
+ * 只有 JSON 值不是数字（例如字符串 "18"）时才回退到 QVariant 的宽松转换
+ * 浮点数按 JsonFloatPrecision::current() 的策略取整后输出
+ * 整数的小数按四舍五入取整，与 QVariant 的转换结果一致；超出 T 取值范围的值收束到最小值或最大值
+ * Qt 6 的 QJsonValue 原生保存 qint64，整数直接读取，Qt 5 中数值以 double 保存
+ * 64 位无符号整数不超过 qint64 最大值时按整数输出，更大的值只能以 double 输出
+ * 布尔、整数、浮点数三种情况在同一模板内以 if constexpr 分派，不再逐个匹配偏特化
+ */
+template <typename T, typename Enable = void>
+struct JsonNumber
+{
+	static QJsonValue toJson(T value);
+
+	static T fromJson(const QJsonValue &json);
+
+private:
+	/**
+	 * @brief 将整数收束到 T 的取值范围
+	 */
+	static T clampInteger(qint64 value);
+
+	/**
+	 * @brief 将浮点数四舍五入后收束到 T 的取值范围
+	 * @details
+	 * 先在 double 上比较再转换，超出范围的值（包括大于 2^63 的 quint64）不会产生未定义的转换；
+	 * 64 位类型的上限在 double 中向上取整为 2^63 或 2^64，因此上下限均以闭区间比较
+	 */
+	static T clampDouble(double value);
+};
+
+template <typename T, typename Enable>
+QJsonValue JsonNumber<T, Enable>::toJson(T value)
+{
+	if constexpr (std::is_same<T, bool>::value)
+	{
+		return QJsonValue(value);
+	}
+	else if constexpr (std::is_integral<T>::value)
+	{
+		if constexpr (std::is_unsigned<T>::value && sizeof(T) >= sizeof(qint64))
+		{
+			// 超出 qint64 范围的值只能以 double 表示
+			if (value > static_cast<quint64>(std::numeric_limits<qint64>::max()))
+			{
+				return QJsonValue(static_cast<double>(value));
+			}
+			return QJsonValue(static_cast<qint64>(value));
+		}
+		else
+		{
+			return QJsonValue(static_cast<qint64>(value));
+		}
+	}
+	else
+	{
+		return QJsonValue(JsonFloatPrecision::current().apply(static_cast<double>(value)));
+	}
+}
+
+template <typename T, typename Enable>
+T JsonNumber<T, Enable>::fromJson(const QJsonValue &json)
+{
+	if constexpr (std::is_same<T, bool>::value)
+	{
+		if (json.isBool())
+		{
+			return json.toBool();
+		}
+	}
+	else if constexpr (std::is_integral<T>::value)
+	{
+		if (json.isDouble())
+		{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+			// 不是整数或超出 qint64 范围时 toInteger() 返回默认值 0，此时按浮点数处理
+			const qint64 integer = json.toInteger(0);
+			if (integer != 0 || json.toDouble() == 0)
+			{
+				return clampInteger(integer);
+			}
+#endif
+			return clampDouble(json.toDouble());
+		}
+	}
+	else
+	{
+		if (json.isDouble())
+		{
+			return static_cast<T>(json.toDouble());
+		}
+	}
+	return json.toVariant().template value<T>();
+}
+
+template <typename T, typename Enable>
+T JsonNumber<T, Enable>::clampInteger(qint64 value)
+{
+	if constexpr (std::is_signed<T>::value)
+	{
+		if (value < static_cast<qint64>(std::numeric_limits<T>::min()))
+		{
+			return std::numeric_limits<T>::min();
+		}
+		if (value > static_cast<qint64>(std::numeric_limits<T>::max()))
+		{
+			return std::numeric_limits<T>::max();
+		}
+	}
+	else
+	{
+		if (value < 0)
+		{
+			return 0;
+		}
+		if (static_cast<quint64>(value) > static_cast<quint64>(std::numeric_limits<T>::max()))
+		{
+			return std::numeric_limits<T>::max();
+		}
+	}
+	return static_cast<T>(value);
+}
+
+template <typename T, typename Enable>
+T JsonNumber<T, Enable>::clampDouble(double value)
+{
+	const double rounded = std::round(value);
+	if (std::isnan(rounded))
+	{
+		return T();
+	}
+	if (rounded <= static_cast<double>(std::numeric_limits<T>::min()))
+	{
+		return std::numeric_limits<T>::min();
+	}
+	if (rounded >= static_cast<double>(std::numeric_limits<T>::max()))
+	{
+		return std::numeric_limits<T>::max();
+	}
+	return static_cast<T>(rounded);
+}
+
 /**
  * @brief 原始类型（数值和字符串）的序列化器特化
  * @tparam T 待序列化的原始类型
@@ -102,19 +443,132 @@ struct Serializer<T, typename std::enable_if<std::is_arithmetic<T>::value || std
 	 * @param value 原始类型的值
 	 * @return QJsonValue 转换后的 JSON 值
 	 */
-	static QJsonValue toJson(const T &value)
-	{
-		return ToJsonValue<T>::convert(value);
-	}
+	static QJsonValue toJson(const T &value);
 
 	/**
 	 * @brief 从 QJsonValue 还原为原始类型
 	 * @param json JSON 值
 	 * @return T 还原后的原始类型值
 	 */
-	static T fromJson(const QJsonValue &json)
+	static T fromJson(const QJsonValue &json);
+};
+
+template <typename T>
+QJsonValue Serializer<T, typename std::enable_if<std::is_arithmetic<T>::value || std::is_same<T, QString>::value>::type>::toJson(const T &value)
+{
+	if constexpr (std::is_arithmetic<T>::value)
+	{
+		return JsonNumber<T>::toJson(value);
+	}
+	else
+	{
+		return QJsonValue(value);
+	}
+}
+
+template <typename T>
+T Serializer<T, typename std::enable_if<std::is_arithmetic<T>::value || std::is_same<T, QString>::value>::type>::fromJson(const QJsonValue &json)
+{
+	if constexpr (std::is_arithmetic<T>::value)
+	{
+		return JsonNumber<T>::fromJson(json);
+	}
+	else
+	{
+		if (json.isString())
+		{
+			return json.toString();
+		}
+		return json.toVariant().template value<T>();
+	}
+}
+
+/**
+ * @brief std::chrono 类型在 JSON 中使用的计数单位
+ * @tparam T std::chrono::duration 或 std::chrono::system_clock 的 time_point 类型
+ * @details
+ * 时长默认按其自身的单位编码（即 count()），时间点默认按距 Unix 纪元的毫秒数编码
+ * 需要其他单位时特化本模板即可，例如：
+ * template <> struct JsonChronoUnit<std::chrono::nanoseconds> { using type = std::chrono::microseconds; };
+ */
+template <typename T>
+struct JsonChronoUnit;
+
+template <typename Rep, typename Period>
+struct JsonChronoUnit<std::chrono::duration<Rep, Period>>
+{
+	using type = std::chrono::duration<Rep, Period>;
+};
+
+template <typename Duration>
+struct JsonChronoUnit<std::chrono::time_point<std::chrono::system_clock, Duration>>
+{
+	using type = std::chrono::milliseconds;
+};
+
+/**
+ * @brief std::chrono 计数值与 QJsonValue 之间的转换
+ * @tparam Unit JSON 中使用的 std::chrono::duration 单位
+ * @details
+ * 整数计数直接以整数读写，不经过浮点字符串或 QVariant 转换
+ * Qt 5 的 QJsonValue 内部以 double 保存数值，绝对值超过 2^53 的计数会丢失精度
+ */
+template <typename Unit>
+struct JsonChronoCount
+{
+	static QJsonValue toJson(const Unit &value)
 	{
-		return json.toVariant().value<T>();
+		return JsonNumber<typename Unit::rep>::toJson(value.count());
+	}
+
+	static Unit fromJson(const QJsonValue &json)
+	{
+		return Unit(JsonNumber<typename Unit::rep>::fromJson(json));
+	}
+};
+
+/**
+ * @brief std::chrono::duration 的序列化器特化
+ * @tparam Rep 计数类型
+ * @tparam Period 计数周期
+ * @details 序列化为 JsonChronoUnit 指定单位下的整数计数
+ */
+template <typename Rep, typename Period>
+struct Serializer<std::chrono::duration<Rep, Period>>
+{
+	using Duration = std::chrono::duration<Rep, Period>;
+	using Unit = typename JsonChronoUnit<Duration>::type;
+
+	static QJsonValue toJson(const Duration &value)
+	{
+		return JsonChronoCount<Unit>::toJson(std::chrono::duration_cast<Unit>(value));
+	}
+
+	static Duration fromJson(const QJsonValue &json)
+	{
+		return std::chrono::duration_cast<Duration>(JsonChronoCount<Unit>::fromJson(json));
+	}
+};
+
+/**
+ * @brief std::chrono::system_clock 时间点的序列化器特化
+ * @tparam Duration 时间点的精度
+ * @details 序列化为距 Unix 纪元的整数计数，单位由 JsonChronoUnit 指定（默认毫秒）
+ */
+template <typename Duration>
+struct Serializer<std::chrono::time_point<std::chrono::system_clock, Duration>>
+{
+	using TimePoint = std::chrono::time_point<std::chrono::system_clock, Duration>;
+	using Unit = typename JsonChronoUnit<TimePoint>::type;
+
+	static QJsonValue toJson(const TimePoint &value)
+	{
+		return JsonChronoCount<Unit>::toJson(std::chrono::duration_cast<Unit>(value.time_since_epoch()));
+	}
+
+	static TimePoint fromJson(const QJsonValue &json)
+	{
+		return TimePoint(std::chrono::duration_cast<Duration>(JsonChronoCount<Unit>::fromJson(json)));
 	}
 };
 
@@ -134,35 +588,42 @@ struct Serializer<Container<T>, typename std::enable_if<std::is_same<Container<T
 	 * @param container 待序列化的容器
 	 * @return QJsonValue 转换后的 JSON 数组
 	 */
-	static QJsonValue toJson(const Container<T> &container)
-	{
-		QJsonArray array;
-		for (const auto &item : container)
-		{
-			array.append(Serializer<T>::toJson(item));
-		}
-		return array;
-	}
+	static QJsonValue toJson(const Container<T> &container);
 
 	/**
 	 * @brief 从 QJsonArray 还原为容器
 	 * @param json JSON 数组值
 	 * @return Container<T> 还原后的容器
 	 */
-	static Container<T> fromJson(const QJsonValue &json)
+	static Container<T> fromJson(const QJsonValue &json);
+};
+
+template <template <typename> class Container, typename T>
+QJsonValue Serializer<Container<T>, typename std::enable_if<std::is_same<Container<T>, QList<T>>::value || std::is_same<Container<T>, QVector<T>>::value>::type>::toJson(const Container<T> &container)
+{
+	QJsonArray array;
+	for (const auto &item : container)
+	{
+		array.append(Serializer<T>::toJson(item));
+	}
+	return array;
+}
+
+template <template <typename> class Container, typename T>
+Container<T> Serializer<Container<T>, typename std::enable_if<std::is_same<Container<T>, QList<T>>::value || std::is_same<Container<T>, QVector<T>>::value>::type>::fromJson(const QJsonValue &json)
+{
+	Container<T> result;
+	if (json.isArray())
 	{
-		Container<T> result;
-		if (json.isArray())
+		QJsonArray array = json.toArray();
+		result.reserve(array.size());
+		for (const auto &item : array)
 		{
-			QJsonArray array = json.toArray();
-			for (const auto &item : array)
-			{
-				result.append(Serializer<T>::fromJson(item));
-			}
+			result.append(Serializer<T>::fromJson(item));
 		}
-		return result;
 	}
-};
+	return result;
+}
 
 /**
  * @brief std::vector 容器的序列化器特化
@@ -179,44 +640,285 @@ struct Serializer<std::vector<T>>
 	 * @param container 待序列化的 std::vector
 	 * @return QJsonValue 转换后的 JSON 数组
 	 */
-	static QJsonValue toJson(const std::vector<T> &container)
-	{
-		QJsonArray array;
-		for (const auto &item : container)
-		{
-			array.append(Serializer<T>::toJson(item));
-		}
-		return array;
-	}
+	static QJsonValue toJson(const std::vector<T> &container);
 
 	/**
 	 * @brief 从 QJsonArray 还原为 std::vector
 	 * @param json JSON 数组值
 	 * @return std::vector<T> 还原后的 std::vector
 	 */
-	static std::vector<T> fromJson(const QJsonValue &json)
+	static std::vector<T> fromJson(const QJsonValue &json);
+};
+
+template <typename T>
+QJsonValue Serializer<std::vector<T>>::toJson(const std::vector<T> &container)
+{
+	QJsonArray array;
+	for (const auto &item : container)
+	{
+		array.append(Serializer<T>::toJson(item));
+	}
+	return array;
+}
+
+template <typename T>
+std::vector<T> Serializer<std::vector<T>>::fromJson(const QJsonValue &json)
+{
+	std::vector<T> result;
+	if (json.isArray())
 	{
-		std::vector<T> result;
-		if (json.isArray())
+		QJsonArray array = json.toArray();
+		result.reserve(array.size());
+		for (const auto &item : array)
 		{
-			QJsonArray array = json.toArray();
-			for (const auto &item : array)
-			{
-				result.push_back(Serializer<T>::fromJson(item));
-			}
+			result.push_back(Serializer<T>::fromJson(item));
 		}
-		return result;
 	}
-};
+	return result;
+}
 
 /**
- * @brief Qt 关联容器（QMap 和 QHash）的序列化器特化
- * @tparam Map 容器类型（QMap 或 QHash）
+ * @brief 映射容器键的编解码器
  * @tparam K 键的类型
- * @tparam V 值的类型
+ * @details
+ * JSON 对象的键只能是字符串，映射容器的键需要与字符串相互转换
+ * 整数键直接在 UTF-16 缓冲区上格式化和解析十进制数，不经过 QVariant 和 QJsonValue；
+ * 无法解析或超出 K 取值范围的键解析失败，映射容器的各种解码路径都会跳过该项，
+ * 避免多个无效键都还原为 K() 而相互覆盖；
+ * 枚举键按底层整数值转换；浮点数键按 QString::toDouble() 解析；其他类型经由 QVariant 转换
+ * QString 和 QUuid 有直接转换的特化
+ */
+template <typename K, typename Enable = void>
+struct KeyCodec
+{
+	/**
+	 * @brief 将键转换为 JSON 对象的键
+	 * @param key 映射容器的键
+	 * @return QString 字符串形式的键
+	 */
+	static QString toKey(const K &key);
+
+	/**
+	 * @brief 从 JSON 对象的键还原映射容器的键
+	 * @param key 字符串形式的键
+	 * @param result 还原得到的键，失败时不修改
+	 * @return bool 键能够解析且在 K 的取值范围内时返回 true
+	 */
+	static bool fromKey(const QString &key, K &result);
+
+private:
+	static QString formatInteger(K key);
+
+	/**
+	 * @brief 解析十进制整数键
+	 * @details 逐位检查溢出，超出 K 取值范围的键视为解析失败
+	 */
+	static bool parseInteger(const QString &key, K &result);
+
+	static bool parseFallback(const QString &key, K &result);
+};
+
+template <typename K, typename Enable>
+QString KeyCodec<K, Enable>::toKey(const K &key)
+{
+	if constexpr (std::is_enum<K>::value)
+	{
+		using Underlying = typename std::underlying_type<K>::type;
+		return KeyCodec<Underlying>::toKey(static_cast<Underlying>(key));
+	}
+	else if constexpr (std::is_integral<K>::value && !std::is_same<K, bool>::value)
+	{
+		return formatInteger(key);
+	}
+	else
+	{
+		return ToJsonValue<K>::convert(key).toString();
+	}
+}
+
+template <typename K, typename Enable>
+bool KeyCodec<K, Enable>::fromKey(const QString &key, K &result)
+{
+	if constexpr (std::is_enum<K>::value)
+	{
+		using Underlying = typename std::underlying_type<K>::type;
+		Underlying value;
+		if (!KeyCodec<Underlying>::fromKey(key, value))
+		{
+			return false;
+		}
+		result = static_cast<K>(value);
+		return true;
+	}
+	else if constexpr (std::is_integral<K>::value && !std::is_same<K, bool>::value)
+	{
+		return parseInteger(key, result);
+	}
+	else if constexpr (std::is_floating_point<K>::value)
+	{
+		bool ok = false;
+		const double value = key.toDouble(&ok);
+		if (ok)
+		{
+			result = static_cast<K>(value);
+		}
+		return ok;
+	}
+	else
+	{
+		QVariant value(key);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+		if (!value.convert(QMetaType::fromType<K>()))
+#else
+		if (!value.convert(qMetaTypeId<K>()))
+#endif
+		{
+			return false;
+		}
+		result = value.template value<K>();
+		return true;
+	}
+}
+
+template <typename K, typename Enable>
+QString KeyCodec<K, Enable>::formatInteger(K key)
+{
+	using Unsigned = typename std::make_unsigned<K>::type;
+	QChar buffer[24];
+	int pos = 24;
+	bool negative = key < 0;
+	// 以无符号形式取绝对值，避免最小负数取反溢出
+	Unsigned magnitude = negative ? 0 - static_cast<Unsigned>(key) : static_cast<Unsigned>(key);
+	do
+	{
+		buffer[--pos] = QChar(static_cast<ushort>('0' + magnitude % 10));
+		magnitude /= 10;
+	} while (magnitude != 0);
+	if (negative)
+	{
+		buffer[--pos] = QChar(static_cast<ushort>('-'));
+	}
+	return QString(buffer + pos, 24 - pos);
+}
+
+template <typename K, typename Enable>
+bool KeyCodec<K, Enable>::parseInteger(const QString &key, K &result)
+{
+	const QChar *data = key.constData();
+	int size = key.size();
+	int pos = 0;
+	bool negative = size > 0 && data[0].unicode() == '-';
+	if (negative)
+	{
+		pos = 1;
+	}
+	if (pos == size)
+	{
+		return parseFallback(key, result);
+	}
+	// 允许的最大绝对值：负数为 min() 的绝对值，非负数为 max()
+	quint64 limit = static_cast<quint64>(std::numeric_limits<K>::max());
+	if (negative)
+	{
+		limit = std::is_signed<K>::value ? limit + 1 : 0;
+	}
+	quint64 magnitude = 0;
+	for (; pos < size; ++pos)
+	{
+		ushort digit = data[pos].unicode() - '0';
+		if (digit > 9)
+		{
+			return parseFallback(key, result);
+		}
+		if (magnitude > limit / 10 || (magnitude == limit / 10 && digit > limit % 10))
+		{
+			return false;
+		}
+		magnitude = magnitude * 10 + digit;
+	}
+	if (negative && magnitude != 0)
+	{
+		// magnitude 不超过 2^63，先减一再取反，避免有符号溢出
+		result = static_cast<K>(-static_cast<qint64>(magnitude - 1) - 1);
+		return true;
+	}
+	result = static_cast<K>(magnitude);
+	return true;
+}
+
+template <typename K, typename Enable>
+bool KeyCodec<K, Enable>::parseFallback(const QString &key, K &result)
+{
+	bool ok = false;
+	if constexpr (std::is_signed<K>::value)
+	{
+		qlonglong value = key.toLongLong(&ok);
+		if (!ok || value < static_cast<qlonglong>(std::numeric_limits<K>::min()) || value > static_cast<qlonglong>(std::numeric_limits<K>::max()))
+		{
+			return false;
+		}
+		result = static_cast<K>(value);
+	}
+	else
+	{
+		qulonglong value = key.toULongLong(&ok);
+		if (!ok || value > static_cast<qulonglong>(std::numeric_limits<K>::max()))
+		{
+			return false;
+		}
+		result = static_cast<K>(value);
+	}
+	return true;
+}
+
+template <>
+struct KeyCodec<QString>
+{
+	static const QString &toKey(const QString &key)
+	{
+		return key;
+	}
+
+	static bool fromKey(const QString &key, QString &result)
+	{
+		result = key;
+		return true;
+	}
+};
+
+template <>
+struct KeyCodec<QUuid>
+{
+	static QString toKey(const QUuid &key)
+	{
+#if QT_VERSION < QT_VERSION_CHECK(5, 11, 0)
+		return key.toString();
+#else
+		return key.toString(QUuid::WithoutBraces);
+#endif
+	}
+
+	static bool fromKey(const QString &key, QUuid &result)
+	{
+		// 无法解析的字符串得到空 UUID，只有键本身就是空 UUID 时才算成功
+		const QUuid uuid(key);
+		if (uuid.isNull() && key != toKey(QUuid()) && key != QUuid().toString())
+		{
+			return false;
+		}
+		result = uuid;
+		return true;
+	}
+};
+
+/**
+ * @brief Qt 关联容器（QMap 和 QHash）的序列化器特化
+ * @tparam Map 容器类型（QMap 或 QHash）
+ * @tparam K 键的类型
+ * @tparam V 值的类型
  * @details
  * 支持将 QMap 和 QHash 序列化为 QJsonObject
- * 使用键的字符串表示作为 JSON 对象的键
+ * 键通过 KeyCodec 转换为 JSON 对象的字符串键
  */
 template <template <typename, typename> class Map, typename K, typename V>
 struct Serializer<Map<K, V>, typename std::enable_if<std::is_same<Map<K, V>, QMap<K, V>>::value || std::is_same<Map<K, V>, QHash<K, V>>::value>::type>
@@ -226,36 +928,45 @@ struct Serializer<Map<K, V>, typename std::enable_if<std::is_same<Map<K, V>, QMa
 	 * @param map 待序列化的映射容器
 	 * @return QJsonValue 转换后的 JSON 对象
 	 */
-	static QJsonValue toJson(const Map<K, V> &map)
-	{
-		QJsonObject obj;
-		for (auto it = map.begin(); it != map.end(); ++it)
-		{
-			obj.insert(ToJsonValue<K>::convert(it.key()).toString(), Serializer<V>::toJson(it.value()));
-		}
-		return obj;
-	}
+	static QJsonValue toJson(const Map<K, V> &map);
 
 	/**
 	 * @brief 从 QJsonObject 还原为 QMap/QHash
 	 * @param json JSON 对象值
 	 * @return Map<K, V> 还原后的映射容器
 	 */
-	static Map<K, V> fromJson(const QJsonValue &json)
+	static Map<K, V> fromJson(const QJsonValue &json);
+};
+
+template <template <typename, typename> class Map, typename K, typename V>
+QJsonValue Serializer<Map<K, V>, typename std::enable_if<std::is_same<Map<K, V>, QMap<K, V>>::value || std::is_same<Map<K, V>, QHash<K, V>>::value>::type>::toJson(const Map<K, V> &map)
+{
+	QJsonObject obj;
+	for (auto it = map.begin(); it != map.end(); ++it)
 	{
-		Map<K, V> result;
-		if (json.isObject())
+		obj.insert(KeyCodec<K>::toKey(it.key()), Serializer<V>::toJson(it.value()));
+	}
+	return obj;
+}
+
+template <template <typename, typename> class Map, typename K, typename V>
+Map<K, V> Serializer<Map<K, V>, typename std::enable_if<std::is_same<Map<K, V>, QMap<K, V>>::value || std::is_same<Map<K, V>, QHash<K, V>>::value>::type>::fromJson(const QJsonValue &json)
+{
+	Map<K, V> result;
+	if (json.isObject())
+	{
+		QJsonObject obj = json.toObject();
+		for (auto it = obj.begin(); it != obj.end(); ++it)
 		{
-			QJsonObject obj = json.toObject();
-			for (auto it = obj.begin(); it != obj.end(); ++it)
+			K key;
+			if (KeyCodec<K>::fromKey(it.key(), key))
 			{
-				result.insert(ToJsonValue<K>::convert(it.key()).toVariant().value<K>(),
-							  Serializer<V>::fromJson(it.value()));
+				result.insert(key, Serializer<V>::fromJson(it.value()));
 			}
 		}
-		return result;
 	}
-};
+	return result;
+}
 
 /**
  * @brief std::map 容器的序列化器特化
@@ -278,7 +989,7 @@ struct Serializer<std::map<K, V>>
 		QJsonObject jsonObject;
 		for (const auto &pair : map)
 		{
-			QString key = ToJsonValue<K>::convert(pair.first).toString();
+			QString key = KeyCodec<K>::toKey(pair.first);
 			QJsonValue value = Serializer<V>::toJson(pair.second);
 			jsonObject.insert(key, value);
 		}
@@ -298,7 +1009,11 @@ struct Serializer<std::map<K, V>>
 			QJsonObject jsonObject = json.toObject();
 			for (auto it = jsonObject.begin(); it != jsonObject.end(); ++it)
 			{
-				K key = ToJsonValue<K>::convert(it.key()).toVariant().value<K>();
+				K key;
+				if (!KeyCodec<K>::fromKey(it.key(), key))
+				{
+					continue;
+				}
 				V value = Serializer<V>::fromJson(it.value());
 				result.insert({key, value});
 			}
@@ -308,176 +1023,4161 @@ struct Serializer<std::map<K, V>>
 };
 
 /**
- * @brief JSON 可序列化标记宏
- * @details 为类添加元对象支持，简化元对象方法的实现
- */
-#define JSON_SERIALIZABLE                         \
-	virtual const QMetaObject *metaObject() const \
-	{                                             \
-                                                  \
-		return &this->staticMetaObject;           \
-	}
-
-/**
- * @brief 可序列化基类
- * @details 提供通用的 JSON 序列化和反序列化方法
- * 子类需要实现 metaObject() 方法
+ * @brief 紧凑 JSON 写入器
+ * @details
+ * 直接向 QByteArray 追加 UTF-8 编码的紧凑 JSON，不构建 QJsonValue/QJsonObject 中间对象
+ * 对象的键按 QJsonObject 的顺序（字符串升序）输出，结果与 QJsonDocument::Compact 一致
+ * write() 通过 const 引用读取数据，只读访问隐式共享的 QString 和容器，不修改其引用计数，
+ * 多个线程可以同时序列化同一批不可变对象而不产生缓存行争用
+ * @code
+ * QByteArray json = JsonWriter::serialize(pagedPerson);
+ * @endcode
  */
-class JsonSerializable
+class JsonWriter
 {
-	Q_GADGET
 public:
-	virtual ~JsonSerializable() = default;
+	explicit JsonWriter(QByteArray &buffer)
+		: m_buffer(buffer)
+	{
+	}
+
+	JsonWriter(const JsonWriter &) = delete;
+	JsonWriter &operator=(const JsonWriter &) = delete;
+
 	/**
-	 * @brief 将 QJsonValue 转换为 JSON 字节数组
-	 * @param value 待转换的 JSON 值
-	 * @return QByteArray JSON 的字节数组表示
+	 * @brief 序列化任意可序列化值为紧凑 JSON
+	 * @tparam T 值的类型
+	 * @param value 待序列化的值
+	 * @return QByteArray 紧凑 JSON 的字节数组
 	 */
-	static QByteArray toByteArray(const QJsonValue &value)
+	template <typename T>
+	static QByteArray serialize(const T &value)
 	{
-		return QJsonDocument(value.toObject()).toJson();
+		QByteArray buffer;
+		JsonWriter writer(buffer);
+		writer.write(value);
+		return buffer;
 	}
-	
+
 	/**
-	 * @brief 序列化对象的所有 JSON 属性
-	 * @return QJsonObject 包含对象属性的 JSON 对象
+	 * @brief 按值的类型写入
+	 * @details 由 JsonWrite<T> 分派，没有直接写入方式的类型经由 Serializer<T> 转换为 QJsonValue 后写入
 	 */
-	QJsonObject toJson() const
+	template <typename T>
+	void write(const T &value);
+
+	/**
+	 * @brief 设置输出接收函数，流式消费输出
+	 * @details 缓冲区达到 threshold 字节后，在写下一个值之前把已写出的内容交给 sink 并清空缓冲区，
+	 * 缓冲区的容量保留复用，内存占用与文档大小无关；写完后调用 flush() 交出剩余内容
+	 * @param sink 接收一段输出的函数
+	 * @param threshold 缓冲区阈值（字节）
+	 */
+	void setSink(std::function<void(const char *, int)> sink, int threshold = 4096)
 	{
-		QJsonObject json;
-		auto metaObject = this->metaObject();
-		int propCount = metaObject->propertyCount();
-		for (int i = 0; i < propCount; i++)
-		{
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-			if (QString(metaObject->property(i).typeName()) != QMetaType::typeName(qMetaTypeId<QJsonValue>()))
-			{
-				continue;
-			}
-#else
-			if (metaObject->property(i).metaType().id() != QMetaType::QJsonValue)
-			{
-				continue;
-			}
-#endif
+		m_sink = std::move(sink);
+		m_threshold = threshold;
+		m_buffer.reserve(threshold * 2);
+	}
 
-			auto key = metaObject->property(i).name();
-			auto value = metaObject->property(i).readOnGadget(this).toJsonValue();
-			json.insert(key, value);
+	/**
+	 * @brief 把缓冲区中的内容交给输出接收函数并清空缓冲区
+	 */
+	void flush()
+	{
+		if (m_sink && !m_buffer.isEmpty())
+		{
+			m_sink(m_buffer.constData(), m_buffer.size());
+			m_buffer.resize(0);
 		}
-		return json;
+	}
+
+	void beginObject()
+	{
+		separate();
+		m_buffer.append('{');
+		m_first = true;
+	}
+
+	void endObject()
+	{
+		m_buffer.append('}');
+		m_first = false;
+	}
+
+	void beginArray()
+	{
+		separate();
+		m_buffer.append('[');
+		m_first = true;
+	}
+
+	void endArray()
+	{
+		m_buffer.append(']');
+		m_first = false;
 	}
 
 	/**
-	 * @brief 返回对象的 JSON 原始字节数据
-	 * @return QByteArray JSON 的原始字节数据
+	 * @brief 写入对象的键
+	 * @param key 键，写入时转义
 	 */
-	QByteArray toRawJson() const
+	void writeKey(const QString &key)
 	{
-		return toByteArray(toJson());
+		separate();
+		appendString(m_buffer, key);
+		m_buffer.append(':');
+		m_afterKey = true;
 	}
 
 	/**
-	 * @brief 从 JSON 值反序列化对象属性
-	 * @param val 包含属性的 JSON 值
+	 * @brief 写入预先转义的键
+	 * @param quotedKey quoted() 生成的带引号的键
 	 */
-	void fromJson(const QJsonValue &val)
+	void writeQuotedKey(const QByteArray &quotedKey)
+	{
+		separate();
+		m_buffer.append(quotedKey);
+		m_buffer.append(':');
+		m_afterKey = true;
+	}
+
+	void writeNull()
 	{
-		if (val.isObject())
+		separate();
+		m_buffer.append("null", 4);
+	}
+
+	void writeBool(bool value)
+	{
+		separate();
+		if (value)
 		{
-			QJsonObject json = val.toObject();
-			QStringList keys = json.keys();
-			auto metaObject = this->metaObject();
-			int propCount = metaObject->propertyCount();
-			for (int i = 0; i < propCount; i++)
-			{
+			m_buffer.append("true", 4);
+		}
+		else
+		{
+			m_buffer.append("false", 5);
+		}
+	}
+
+	/**
+	 * @brief 写入整数
+	 * @details Qt 5 的 QJsonValue 以 double 保存数值，为与其输出一致按 double 格式化
+	 */
+	void writeInteger(qint64 value)
+	{
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-				if (QString(metaObject->property(i).typeName()) != QMetaType::typeName(qMetaTypeId<QJsonValue>()))
-				{
-					continue;
-				}
+		writeDouble(static_cast<double>(value));
 #else
-				if (metaObject->property(i).metaType().id() != QMetaType::QJsonValue)
-				{
-					continue;
-				}
+		separate();
+		m_buffer.append(QByteArray::number(value));
 #endif
-
-				QString propertyName = metaObject->property(i).name();
-				for (const auto &key : json.keys())
-				{
-					// Reading JSON properties is case-insensitive
-					if (key.compare(propertyName, Qt::CaseInsensitive) == 0)
-					{
-						metaObject->property(i).writeOnGadget(this, json.value(key));
-						break;
-					}
-				}
-			}
-		}
 	}
-	
+
 	/**
-	 * @brief 从 JSON 字节数组反序列化对象
-	 * @param data JSON 的字节数组
+	 * @brief 写入浮点数，非有限值写为 null
 	 */
-	void fromJson(const QByteArray &data)
+	void writeDouble(double value)
 	{
-		fromJson(QJsonDocument::fromJson(data).object());
+		separate();
+		if (!std::isfinite(value))
+		{
+			m_buffer.append("null", 4);
+			return;
+		}
+#if QT_VERSION < QT_VERSION_CHECK(5, 7, 0)
+		m_buffer.append(QByteArray::number(value, 'g', std::numeric_limits<double>::digits10 + 2));
+#else
+		m_buffer.append(QByteArray::number(value, 'g', QLocale::FloatingPointShortest));
+#endif
 	}
 
-protected:
-	virtual const QMetaObject *metaObject() const = 0;
-};
+	void writeString(const QString &value)
+	{
+		separate();
+		appendString(m_buffer, value);
+	}
 
-/**
- * @brief 自定义类型（继承自 JsonSerializable）的序列化器特化
- * @tparam T 继承自 JsonSerializable 的自定义类型
- * @details
- * 针对继承自 JsonSerializable 的类型提供特化的序列化和反序列化支持
- * 调用对象的 toJson() 和 fromJson() 方法
- */
-template <typename T>
-struct Serializer<T, typename std::enable_if<std::is_base_of<JsonSerializable, T>::value>::type>
-{
 	/**
-	 * @brief 将自定义对象转换为 QJsonValue
-	 * @param value 待序列化的对象
-	 * @return QJsonValue 转换后的 JSON 值
+	 * @brief 写入一段已编码的 JSON 值
+	 * @details 用于拼接缓存的片段，内容不做校验
+	 * @param json 完整的紧凑 JSON 值
 	 */
-	static QJsonValue toJson(const T &value)
+	void writeRaw(const QByteArray &json)
 	{
-		return value.toJson();
+		separate();
+		m_buffer.append(json);
 	}
 
 	/**
-	 * @brief 从 QJsonValue 还原为自定义对象
-	 * @param json JSON 值
-	 * @return T 还原后的自定义对象
+	 * @brief 写入 QJsonValue
+	 * @details 作为没有直接写入方式的类型的回退路径
 	 */
-	static T fromJson(const QJsonValue &json)
+	void writeValue(const QJsonValue &value)
 	{
-		T result;
-		result.fromJson(json.toObject());
-		return result;
-	}
-};
-
-/**
- * @brief JSON 属性声明宏、使用Serializer<T>进行展开
- * @details 简化 JSON 属性的声明、获取和设置
- * @param type 属性的数据类型
+		switch (value.type())
+		{
+		case QJsonValue::Bool:
+			writeBool(value.toBool());
+			break;
+		case QJsonValue::Double:
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+			// 以整数保存的数值按整数输出
+			if (value.toVariant().userType() == QMetaType::LongLong)
+			{
+				writeInteger(value.toInteger());
+				break;
+			}
+#endif
+			writeDouble(value.toDouble());
+			break;
+		case QJsonValue::String:
+			writeString(value.toString());
+			break;
+		case QJsonValue::Array:
+		{
+			const QJsonArray array = value.toArray();
+			beginArray();
+			for (const QJsonValue &item : array)
+			{
+				writeValue(item);
+			}
+			endArray();
+			break;
+		}
+		case QJsonValue::Object:
+		{
+			const QJsonObject object = value.toObject();
+			beginObject();
+			for (auto it = object.constBegin(); it != object.constEnd(); ++it)
+			{
+				writeKey(it.key());
+				writeValue(it.value());
+			}
+			endObject();
+			break;
+		}
+		default:
+			writeNull();
+			break;
+		}
+	}
+
+	/**
+	 * @brief 生成带引号、已转义的 UTF-8 字符串，供 writeQuotedKey() 使用
+	 */
+	static QByteArray quoted(const QString &text)
+	{
+		QByteArray result;
+		appendString(result, text);
+		return result;
+	}
+
+private:
+	void separate()
+	{
+		if (m_sink && m_buffer.size() >= m_threshold)
+		{
+			flush();
+		}
+		if (m_afterKey)
+		{
+			m_afterKey = false;
+		}
+		else if (m_first)
+		{
+			m_first = false;
+		}
+		else
+		{
+			m_buffer.append(',');
+		}
+	}
+
+	/**
+	 * @brief 将 UTF-16 字符串转义并编码为 UTF-8 追加到缓冲区
+	 * @details 转义规则与 QJsonDocument 相同：引号、反斜杠与控制字符转义，其余字符原样输出
+	 */
+	static void appendString(QByteArray &buffer, const QString &text)
+	{
+		static const char hex[] = "0123456789abcdef";
+		const QChar *data = text.constData();
+		const int size = text.size();
+		buffer.reserve(buffer.size() + size + 2);
+		buffer.append('"');
+		for (int i = 0; i < size; ++i)
+		{
+			uint u = data[i].unicode();
+			if (u < 0x80)
+			{
+				switch (u)
+				{
+				case '"':
+					buffer.append("\\\"", 2);
+					break;
+				case '\\':
+					buffer.append("\\\\", 2);
+					break;
+				case '\b':
+					buffer.append("\\b", 2);
+					break;
+				case '\f':
+					buffer.append("\\f", 2);
+					break;
+				case '\n':
+					buffer.append("\\n", 2);
+					break;
+				case '\r':
+					buffer.append("\\r", 2);
+					break;
+				case '\t':
+					buffer.append("\\t", 2);
+					break;
+				default:
+					if (u < 0x20)
+					{
+						const char escaped[6] = {'\\', 'u', '0', '0', hex[u >> 4], hex[u & 0xf]};
+						buffer.append(escaped, 6);
+					}
+					else
+					{
+						buffer.append(static_cast<char>(u));
+					}
+					break;
+				}
+				continue;
+			}
+			if (u >= 0xd800 && u < 0xdc00 && i + 1 < size && data[i + 1].unicode() >= 0xdc00 && data[i + 1].unicode() < 0xe000)
+			{
+				u = 0x10000 + ((u - 0xd800) << 10) + (data[++i].unicode() - 0xdc00);
+			}
+			if (u < 0x800)
+			{
+				const char bytes[2] = {static_cast<char>(0xc0 | (u >> 6)), static_cast<char>(0x80 | (u & 0x3f))};
+				buffer.append(bytes, 2);
+			}
+			else if (u < 0x10000)
+			{
+				const char bytes[3] = {static_cast<char>(0xe0 | (u >> 12)), static_cast<char>(0x80 | ((u >> 6) & 0x3f)), static_cast<char>(0x80 | (u & 0x3f))};
+				buffer.append(bytes, 3);
+			}
+			else
+			{
+				const char bytes[4] = {static_cast<char>(0xf0 | (u >> 18)), static_cast<char>(0x80 | ((u >> 12) & 0x3f)), static_cast<char>(0x80 | ((u >> 6) & 0x3f)), static_cast<char>(0x80 | (u & 0x3f))};
+				buffer.append(bytes, 4);
+			}
+		}
+		buffer.append('"');
+	}
+
+	QByteArray &m_buffer;
+	bool m_first = true;
+	bool m_afterKey = false;
+	std::function<void(const char *, int)> m_sink;
+	int m_threshold = 0;
+};
+
+/**
+ * @brief 可恢复编码的一帧
+ * @details
+ * 表示一个正在写出的对象或数组，每次 step() 只写出一个成员或元素，
+ * 遍历位置保存在帧中，由调用方以显式栈驱动，可以在任意两步之间暂停
+ */
+class JsonEncodeFrame
+{
+public:
+	virtual ~JsonEncodeFrame() = default;
+
+	/**
+	 * @brief 执行一步
+	 * @param writer 写入器
+	 * @param child 需要逐步展开下一个值时接收其子帧，由调用方压栈后继续驱动
+	 * @return bool 帧已写完（容器已闭合）时返回 true
+	 */
+	virtual bool step(JsonWriter &writer, std::unique_ptr<JsonEncodeFrame> &child) = 0;
+};
+
+/**
+ * @brief JSON 属性的类型化成员访问接口
+ * @details
+ * 由 JSON_PROPERTY_WITH 为每个属性生成一个静态实现，经 JsonFieldRegistry 登记到 JsonPropertyTable::of<T>()，
+ * 使写入器可以按 const 引用直接读取成员，不经过 readOnGadget() 的 QVariant/QJsonValue 拷贝
+ */
+class JsonFieldAccess
+{
+public:
+	/**
+	 * @brief 将对象中对应成员的值写入写入器
+	 * @param writer 写入器
+	 * @param gadget 对象地址（Q_GADGET 类实例）
+	 */
+	virtual void write(JsonWriter &writer, const void *gadget) const = 0;
+
+	/**
+	 * @brief 为对象中对应成员创建可恢复编码的帧
+	 * @param gadget 对象地址（Q_GADGET 类实例）
+	 * @return std::unique_ptr<JsonEncodeFrame> 成员不能逐步展开时返回空，由 write() 一次写出
+	 */
+	virtual std::unique_ptr<JsonEncodeFrame> encodeFrame(const void *gadget) const = 0;
+
+	/**
+	 * @brief 比较两个对象中对应成员，生成合并补丁的值
+	 * @param before 修改前的对象地址
+	 * @param after 修改后的对象地址
+	 * @param patch 成员有变化时接收补丁值（嵌套对象为嵌套补丁，其余为修改后的完整值）
+	 * @return bool 成员有变化时返回 true
+	 */
+	virtual bool diff(const void *before, const void *after, QJsonValue &patch) const = 0;
+
+	/**
+	 * @brief 将合并补丁的值原地应用到对象中对应成员
+	 * @param gadget 对象地址（Q_GADGET 类实例）
+	 * @param patch 补丁值：null 重置成员，对象递归合并，其余值替换
+	 */
+	virtual void patch(void *gadget, const QJsonValue &patch) const = 0;
+
+	/**
+	 * @brief 以 JSON 值覆盖对象中对应成员，沿用成员原有的存储，见 JsonAssign
+	 * @param gadget 对象地址（Q_GADGET 类实例）
+	 * @param json JSON 值
+	 */
+	virtual void assign(void *gadget, const QJsonValue &json) const = 0;
+
+	/**
+	 * @brief 将对象中对应成员恢复为默认构造的对象中的值
+	 * @param gadget 对象地址（Q_GADGET 类实例）
+	 */
+	virtual void reset(void *gadget) const = 0;
+
+	/**
+	 * @brief 清空对象中对应的序列容器成员，准备逐个追加元素，见 JsonAppend
+	 * @param gadget 对象地址（Q_GADGET 类实例）
+	 * @return bool 成员是以默认编解码的序列容器时返回 true；否则不修改成员并返回 false
+	 */
+	virtual bool clearSequence(void *gadget) const = 0;
+
+	/**
+	 * @brief 向对象中对应的序列容器成员追加一个元素，仅在 clearSequence() 返回 true 后调用
+	 * @param gadget 对象地址（Q_GADGET 类实例）
+	 * @param element 元素的 JSON 值
+	 */
+	virtual void appendElement(void *gadget, const QJsonValue &element) const = 0;
+
+	/**
+	 * @brief 将数组的一段元素解码为与成员同类型的独立容器
+	 * @details 不访问对象，可在多个线程中并行调用，见 JsonAppend
+	 * @param elements 一段数组元素
+	 * @return std::shared_ptr<void> 解码得到的容器；成员不是以默认编解码的序列容器时返回空
+	 */
+	virtual std::shared_ptr<void> decodeElements(const QJsonArray &elements) const = 0;
+
+	/**
+	 * @brief 按顺序拼接 decodeElements() 的结果并替换对象中对应成员，元素移动而不复制
+	 * @param gadget 对象地址（Q_GADGET 类实例）
+	 * @param parts decodeElements() 返回的各段，按元素在数组中的顺序排列，拼接后被移空
+	 */
+	virtual void spliceElements(void *gadget, const std::vector<std::shared_ptr<void>> &parts) const = 0;
+
+	/**
+	 * @brief 成员是否经由共享指针持有对象（包括容器中的共享指针），见 JsonHoldsShared
+	 */
+	virtual bool holdsShared() const = 0;
+
+protected:
+	~JsonFieldAccess() = default;
+};
+
+/**
+ * @brief JSON 属性成员访问接口的登记表
+ * @details
+ * JSON_PROPERTY_WITH 在静态初始化阶段为每个属性登记一项，以声明该属性的类的元对象为键，
+ * JsonPropertyTable::of<T>() 构建属性表时沿 T 的元对象继承链取得各属性的 JsonFieldAccess
+ * 登记与其他全局对象的初始化顺序无关：在登记之前（例如在其他全局对象的构造函数中）首次使用的类，
+ * 其属性表没有成员访问接口，所有属性经由 readOnGadget()/writeOnGadget() 读写，输出相同
+ */
+class JsonFieldRegistry
+{
+public:
+	/**
+	 * @brief 登记属性的成员访问接口
+	 * @param metaObject 声明属性的类的元对象
+	 * @param name 属性名
+	 * @param access 成员访问接口，需在程序运行期间保持有效
+	 * @return bool 始终返回 true，供静态成员的初始化使用
+	 */
+	static bool add(const QMetaObject *metaObject, const char *name, const JsonFieldAccess *access)
+	{
+		QMutexLocker locker(&mutex());
+		registrations()[metaObject].append({name, access});
+		return true;
+	}
+
+	/**
+	 * @brief 取得元对象及其基类登记的成员访问接口
+	 * @details 派生类与基类有同名属性时取派生类的登记
+	 * @param metaObject 元对象
+	 * @return QHash<QString, const JsonFieldAccess *> 按属性名索引的成员访问接口
+	 */
+	static QHash<QString, const JsonFieldAccess *> accessesOf(const QMetaObject *metaObject)
+	{
+		QHash<QString, const JsonFieldAccess *> accesses;
+		QMutexLocker locker(&mutex());
+		for (; metaObject; metaObject = metaObject->superClass())
+		{
+			for (const Registration &registration : registrations().value(metaObject))
+			{
+				QString name = QString::fromLatin1(registration.name);
+				if (!accesses.contains(name))
+				{
+					accesses.insert(name, registration.access);
+				}
+			}
+		}
+		return accesses;
+	}
+
+private:
+	struct Registration
+	{
+		const char *name;
+		const JsonFieldAccess *access;
+	};
+
+	static QMutex &mutex()
+	{
+		static QMutex instance;
+		return instance;
+	}
+
+	static QHash<const QMetaObject *, QVector<Registration>> &registrations()
+	{
+		static QHash<const QMetaObject *, QVector<Registration>> instance;
+		return instance;
+	}
+};
+
+/**
+ * @brief 属性的登记项
+ * @details
+ * JSON_PROPERTY_WITH 生成的成员函数引用 registered，使其随类的定义隐式实例化，
+ * 并在静态初始化阶段把属性的成员访问接口登记到 JsonFieldRegistry
+ * @tparam Self 声明属性的类
+ * @tparam Field JSON_PROPERTY_WITH 生成的属性描述
+ */
+template <typename Self, typename Field>
+struct JsonFieldBinding
+{
+	static const bool registered;
+};
+
+template <typename Self, typename Field>
+const bool JsonFieldBinding<Self, Field>::registered =
+	JsonFieldRegistry::add(&Self::staticMetaObject, Field::key(), Field::template access<Self>());
+
+/**
+ * @brief 类的 JSON 属性表
+ * @details
+ * 每个类构建一次，保存全部 JSON 属性及其完整键名与短键名，并预先建立键到属性的查找表
+ * 完整键名即属性名；短键名由 JSON_PROPERTY_ALIAS 指定，未指定时按属性顺序自动分配
+ * （a、b、…、z、aa、…，跳过已被占用的键）
+ * 自动分配的短键名取决于属性的声明顺序，插入或删除属性会改变其后所有属性的短键名，
+ * 只适合收发双方使用同一版本类定义的内部链路；需要长期稳定的短键名时以 JSON_PROPERTY_ALIAS 显式声明
+ * 反序列化时完整键名与显式短键名始终可用；自动短键名只在 JsonCompactKeysScope 中接受，
+ * 避免普通文档中无关的 "a"、"B" 等键误写入属性；查找均不区分大小写
+ * 显式短键名与其他属性的完整键名或另一个短键名（不区分大小写）相同时无法区分，
+ * 构建时输出警告并忽略该短键名，属性改用自动短键名
+ */
+class JsonPropertyTable
+{
+public:
+	/**
+	 * @brief 单个 JSON 属性
+	 */
+	struct Entry
+	{
+		QMetaProperty property; ///< 元对象属性
+		QString name;           ///< 完整键名
+		QString alias;          ///< 短键名
+		QByteArray quotedName;  ///< 写入器使用的带引号完整键名
+		QByteArray quotedAlias; ///< 写入器使用的带引号短键名
+		const JsonFieldAccess *access; ///< 成员访问接口，属性未登记到 JsonFieldRegistry 时为 nullptr
+		bool autoAlias;         ///< 短键名是否为自动分配
+	};
+
+	/**
+	 * @param metaObject 类的元对象
+	 * @param accesses 按属性名登记的成员访问接口，由 of<T>() 从 JsonFieldRegistry 取得
+	 */
+	explicit JsonPropertyTable(const QMetaObject *metaObject, const QHash<QString, const JsonFieldAccess *> &accesses = {})
+	{
+		QHash<QString, QString> explicitAliases;
+		const QLatin1String prefix("json.alias:");
+		for (int i = 0; i < metaObject->classInfoCount(); i++)
+		{
+			QString infoName = QString::fromLatin1(metaObject->classInfo(i).name());
+			if (infoName.startsWith(prefix))
+			{
+				explicitAliases.insert(infoName.mid(prefix.size()), QString::fromLatin1(metaObject->classInfo(i).value()));
+			}
+		}
+
+		for (int i = 0; i < metaObject->propertyCount(); i++)
+		{
+			QMetaProperty property = metaObject->property(i);
+			if (isJsonProperty(property))
+			{
+				QString name = QString::fromLatin1(property.name());
+				m_entries.append({property, name, explicitAliases.value(name), QByteArray(), QByteArray(), accesses.value(name), false});
+			}
+		}
+
+		for (int i = 0; i < m_entries.size(); i++)
+		{
+			addKey(m_exact, m_folded, m_entries[i].name, i);
+		}
+		for (int i = 0; i < m_entries.size(); i++)
+		{
+			Entry &entry = m_entries[i];
+			if (entry.alias.isEmpty())
+			{
+				continue;
+			}
+			// 与其他属性的完整键名或已登记的短键名（不区分大小写）相同的显式短键名无法区分，忽略并改用自动短键名
+			if (m_folded.value(entry.alias.toLower(), i) != i)
+			{
+				qWarning("JsonPropertyTable: alias \"%s\" of %s::%s collides with another key and is ignored",
+						 qPrintable(entry.alias), metaObject->className(), qPrintable(entry.name));
+				entry.alias.clear();
+				continue;
+			}
+			addKey(m_exact, m_folded, entry.alias, i);
+		}
+		int ordinal = 0;
+		for (int i = 0; i < m_entries.size(); i++)
+		{
+			if (m_entries[i].alias.isEmpty())
+			{
+				QString alias;
+				do
+				{
+					alias = autoAlias(ordinal++);
+				} while (m_exact.contains(alias) || m_folded.contains(alias.toLower()));
+				m_entries[i].alias = alias;
+				m_entries[i].autoAlias = true;
+				addKey(m_autoExact, m_autoFolded, alias, i);
+			}
+		}
+
+		for (int i = 0; i < m_entries.size(); i++)
+		{
+			Entry &entry = m_entries[i];
+			entry.quotedName = JsonWriter::quoted(entry.name);
+			entry.quotedAlias = JsonWriter::quoted(entry.alias);
+			m_sharedMembers = m_sharedMembers || !entry.access || entry.access->holdsShared();
+			m_nameOrder.append(i);
+			m_aliasOrder.append(i);
+		}
+		// 写入器按 QJsonObject 的键顺序输出
+		std::sort(m_nameOrder.begin(), m_nameOrder.end(), [this](int a, int b) { return m_entries.at(a).name < m_entries.at(b).name; });
+		std::sort(m_aliasOrder.begin(), m_aliasOrder.end(), [this](int a, int b) { return m_entries.at(a).alias < m_entries.at(b).alias; });
+	}
+
+	JsonPropertyTable(const JsonPropertyTable &) = delete;
+	JsonPropertyTable &operator=(const JsonPropertyTable &) = delete;
+
+	/**
+	 * @brief 生成的序列化代码入口
+	 * @details 由 JSON_REGISTER_GENERATED 登记，登记后 toJson()/fromJson() 直接调用生成的代码
+	 */
+	struct GeneratedCodec
+	{
+		QJsonObject (*toJson)(const void *gadget);                ///< 序列化对象的所有 JSON 属性
+		void (*fromJson)(void *gadget, const QJsonValue &val); ///< 写入 JSON 中出现的属性
+	};
+
+	/**
+	 * @brief 判断元对象属性是否为 JSON_PROPERTY 声明的 JSON 属性
+	 * @param property 元对象属性
+	 * @return bool 属性类型为 QJsonValue 时返回 true
+	 */
+	static bool isJsonProperty(const QMetaProperty &property)
+	{
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+		return QString(property.typeName()) == QMetaType::typeName(qMetaTypeId<QJsonValue>());
+#else
+		return property.metaType().id() == QMetaType::QJsonValue;
+#endif
+	}
+
+	/**
+	 * @brief 返回类型 T 的属性表
+	 * @details
+	 * 每个类型一个函数内静态对象，首次使用后无锁；JSON_SERIALIZABLE 与 JsonSerializableT 使用该表
+	 * 成员访问接口取自 JsonFieldRegistry 中 T 及其基类登记的属性
+	 * @tparam T Q_GADGET 类
+	 * @return const JsonPropertyTable& 属性表
+	 */
+	template <typename T>
+	static const JsonPropertyTable &of()
+	{
+		static const JsonPropertyTable table(&T::staticMetaObject, JsonFieldRegistry::accessesOf(&T::staticMetaObject));
+		return table;
+	}
+
+	/**
+	 * @brief 返回元对象对应的属性表
+	 * @details
+	 * 供没有使用 JSON_SERIALIZABLE 的类使用，结果按元对象缓存并加锁查找
+	 * 只有元对象时无法取得成员访问接口，所有属性经由 readOnGadget()/writeOnGadget() 读写
+	 * @param metaObject 元对象
+	 * @return const JsonPropertyTable& 属性表
+	 */
+	static const JsonPropertyTable &of(const QMetaObject *metaObject)
+	{
+		static QMutex mutex;
+		static QHash<const QMetaObject *, std::shared_ptr<const JsonPropertyTable>> tables;
+		QMutexLocker locker(&mutex);
+		std::shared_ptr<const JsonPropertyTable> &table = tables[metaObject];
+		if (!table)
+		{
+			table = std::make_shared<const JsonPropertyTable>(metaObject);
+		}
+		return *table;
+	}
+
+	const QVector<Entry> &entries() const
+	{
+		return m_entries;
+	}
+
+	/**
+	 * @brief 是否有经由共享指针持有对象的属性
+	 * @details 没有成员访问接口的属性无法判断类型，按有处理
+	 */
+	bool hasSharedMembers() const
+	{
+		return m_sharedMembers;
+	}
+
+	/**
+	 * @brief 登记生成的序列化代码
+	 * @param codec 生成代码的入口，需在程序运行期间保持有效
+	 */
+	void setGeneratedCodec(const GeneratedCodec *codec) const
+	{
+		m_generated.store(codec, std::memory_order_release);
+	}
+
+	/**
+	 * @brief 是否已登记生成的序列化代码
+	 */
+	bool hasGeneratedCodec() const
+	{
+		return m_generated.load(std::memory_order_acquire) != nullptr;
+	}
+
+	/**
+	 * @brief 按键查找属性
+	 * @details 自动分配的短键名只在 JsonCompactKeysScope 中匹配
+	 * @param key JSON 对象的键（完整键名或短键名，不区分大小写）
+	 * @return int 属性在 entries() 中的下标，未找到返回 -1
+	 */
+	int indexOf(const QString &key) const;
+
+	/**
+	 * @brief 按键及其在文档中的位置查找属性，先按当前线程记录的键序推测，见 indexAt()
+	 * @details 供按文档顺序逐个处理成员的解码器（增量解码、流水线解码）使用
+	 * @param key JSON 对象的键
+	 * @param position 键在文档中的位置（从 0 开始）
+	 * @return int 属性在 entries() 中的下标，未找到返回 -1
+	 */
+	int indexOf(const QString &key, int position) const
+	{
+		return indexAt(keyOrder(), position, key);
+	}
+
+	/**
+	 * @brief 输出时使用的键
+	 * @param index 属性在 entries() 中的下标
+	 * @return const QString& 处于 JsonCompactKeysScope 中时返回短键名，否则返回完整键名
+	 */
+	const QString &key(int index) const;
+
+	/**
+	 * @brief 序列化对象的所有 JSON 属性
+	 * @param gadget 对象地址（Q_GADGET 类实例）
+	 * @return QJsonObject 包含对象属性的 JSON 对象
+	 */
+	QJsonObject toJson(const void *gadget) const;
+
+	/**
+	 * @brief 将对象的所有 JSON 属性写入写入器
+	 * @details 通过 JsonFieldAccess 按 const 引用读取成员，不构建 QJsonObject
+	 * @param writer 写入器
+	 * @param gadget 对象地址（Q_GADGET 类实例）
+	 */
+	void write(JsonWriter &writer, const void *gadget) const;
+
+	/**
+	 * @brief 创建对象的可恢复编码帧
+	 * @details 每步写出一个属性，输出与 write() 相同；可逐步展开的属性作为子帧返回
+	 * @param gadget 对象地址（Q_GADGET 类实例），编码完成前必须保持有效且不被修改
+	 * @return std::unique_ptr<JsonEncodeFrame> 对象帧
+	 */
+	std::unique_ptr<JsonEncodeFrame> encodeFrame(const void *gadget) const;
+
+	/**
+	 * @brief 比较同一个类的两个对象，生成 RFC 7386 合并补丁
+	 * @details 逐个属性直接比较成员，只输出有变化的属性；嵌套的可序列化对象输出嵌套补丁
+	 * @param before 修改前的对象地址
+	 * @param after 修改后的对象地址
+	 * @return QJsonObject 合并补丁，没有变化时为空对象
+	 */
+	QJsonObject diff(const void *before, const void *after) const;
+
+	/**
+	 * @brief 原地应用 RFC 7386 合并补丁
+	 * @details 只修改补丁中出现的属性，键不区分大小写；成员在原有存储上修改，见 JsonPatch
+	 * @param gadget 对象地址（Q_GADGET 类实例）
+	 * @param patch 合并补丁
+	 */
+	void patch(void *gadget, const QJsonObject &patch) const;
+
+	/**
+	 * @brief 以 JSON 值覆盖对象的所有 JSON 属性
+	 * @details
+	 * 结果与反序列化得到的新对象相同：出现的属性在原有存储上覆盖，缺少的属性恢复为默认值
+	 * 用于反复把同构的消息解码到同一个对象中，容器、嵌套对象的存储在多次解码之间复用
+	 * @param gadget 对象地址（Q_GADGET 类实例）
+	 * @param val 包含属性的 JSON 值，不是对象时所有属性恢复为默认值
+	 */
+	void assign(void *gadget, const QJsonValue &val) const;
+
+	/**
+	 * @brief 从 JSON 值反序列化对象属性
+	 * @details 只写入 JSON 中出现的属性，键不区分大小写
+	 * @param gadget 对象地址（Q_GADGET 类实例）
+	 * @param val 包含属性的 JSON 值
+	 */
+	void fromJson(void *gadget, const QJsonValue &val) const
+	{
+		if (const GeneratedCodec *generated = m_generated.load(std::memory_order_acquire))
+		{
+			generated->fromJson(gadget, val);
+		}
+		else if (val.isObject())
+		{
+			QJsonObject json = val.toObject();
+			int *order = json.size() > 1 ? keyOrder() : nullptr;
+			int position = 0;
+			for (auto it = json.constBegin(); it != json.constEnd(); ++it)
+			{
+				// Reading JSON properties is case-insensitive
+				int index = indexAt(order, position++, it.key());
+				if (index >= 0)
+				{
+					m_entries.at(index).property.writeOnGadget(gadget, it.value());
+				}
+			}
+		}
+	}
+
+private:
+	class ObjectFrame;
+
+	static void addKey(QHash<QString, int> &exact, QHash<QString, int> &folded, const QString &key, int index)
+	{
+		if (!exact.contains(key))
+		{
+			exact.insert(key, index);
+		}
+		QString foldedKey = key.toLower();
+		if (!folded.contains(foldedKey))
+		{
+			folded.insert(foldedKey, index);
+		}
+	}
+
+	/**
+	 * @brief 按键在对象中的位置推测属性，推测失败时回退到 indexOf()
+	 * @details
+	 * 同一来源的文档通常具有相同的键序列：记录每个位置上次匹配的属性，
+	 * 下次先与该属性的完整键名、短键名直接比较，命中时跳过哈希查找；未命中时查找并更新记录
+	 * 记录按线程与属性表保存（见 keyOrder()）；同一线程交替解码同一个类的不同形状的文档
+	 * （例如完整对象与只含部分属性的对象）时推测会反复失败，每次失败多一次字符串比较
+	 * 只有一个键的对象不参与推测，直接查找，以免覆盖完整对象的记录
+	 * QJsonObject 按键排序遍历，fromJson() 与 assign() 记录的是排序后的键序列，
+	 * 命中与否只取决于文档含有哪些键，与发送方的键序无关；
+	 * 增量解码与流水线解码按文档中的顺序处理成员，经由 indexOf(key, position) 以文档中的位置推测
+	 * @param order keyOrder() 返回的记录，为 nullptr 时不推测
+	 * @param position 键在 JSON 对象中的位置（从 0 开始）
+	 * @param key JSON 对象的键
+	 * @return int 属性在 entries() 中的下标，未找到返回 -1
+	 */
+	int indexAt(int *order, int position, const QString &key) const;
+
+	/**
+	 * @brief 当前线程的键序记录，每个位置保存一个属性下标，-1 表示尚无记录
+	 * @details 每个线程各自保存，多个线程解码同一个类时互不覆盖，也不争用同一缓存行
+	 */
+	int *keyOrder() const
+	{
+		static thread_local std::vector<std::unique_ptr<int[]>> orders;
+		if (orders.size() <= m_id)
+		{
+			orders.resize(m_id + 1);
+		}
+		std::unique_ptr<int[]> &order = orders[m_id];
+		if (!order)
+		{
+			order.reset(new int[m_entries.size()]);
+			std::fill(order.get(), order.get() + m_entries.size(), -1);
+		}
+		return order.get();
+	}
+
+	static std::size_t nextId()
+	{
+		static std::atomic<std::size_t> counter{0};
+		return counter.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static QString autoAlias(int ordinal)
+	{
+		QString alias;
+		do
+		{
+			alias.prepend(QChar(static_cast<ushort>('a' + ordinal % 26)));
+			ordinal = ordinal / 26 - 1;
+		} while (ordinal >= 0);
+		return alias;
+	}
+
+	/**
+	 * @brief 取得属性的成员访问接口，没有时返回 nullptr
+	 */
+	const JsonFieldAccess *fieldAccess(int index) const
+	{
+		return m_entries.at(index).access;
+	}
+
+	QVector<Entry> m_entries;
+	QHash<QString, int> m_exact;
+	QHash<QString, int> m_folded;
+	QHash<QString, int> m_autoExact;
+	QHash<QString, int> m_autoFolded;
+	QVector<int> m_nameOrder;
+	QVector<int> m_aliasOrder;
+	const std::size_t m_id = nextId();
+	mutable std::atomic<const GeneratedCodec *> m_generated{nullptr};
+	bool m_sharedMembers = false;
+};
+
+/**
+ * @brief 短键名输出作用域
+ * @details
+ * 作用域存续期间，当前线程内序列化的对象（包括嵌套对象与列式编码的列名）使用短键名输出，
+ * 用于内部链路的紧凑传输；对外接口保持默认的完整键名
+ * 反序列化始终接受完整键名与 JSON_PROPERTY_ALIAS 显式声明的短键名；
+ * 自动分配的短键名只在作用域中接受，解码以自动短键名输出的数据时需在同样的作用域中进行
+ */
+class JsonCompactKeysScope
+{
+public:
+	/**
+	 * @param compact 作用域内是否使用短键名，传入 false 可在嵌套作用域中恢复完整键名
+	 */
+	explicit JsonCompactKeysScope(bool compact = true)
+		: m_previous(current())
+	{
+		current() = compact;
+	}
+
+	~JsonCompactKeysScope()
+	{
+		current() = m_previous;
+	}
+
+	JsonCompactKeysScope(const JsonCompactKeysScope &) = delete;
+	JsonCompactKeysScope &operator=(const JsonCompactKeysScope &) = delete;
+
+	/**
+	 * @brief 当前线程是否处于短键名输出作用域中
+	 */
+	static bool active()
+	{
+		return current();
+	}
+
+private:
+	static bool &current()
+	{
+		static thread_local bool compact = false;
+		return compact;
+	}
+
+	bool m_previous;
+};
+
+inline int JsonPropertyTable::indexOf(const QString &key) const
+{
+	auto it = m_exact.constFind(key);
+	if (it != m_exact.constEnd())
+	{
+		return it.value();
+	}
+	const QString folded = key.toLower();
+	int index = m_folded.value(folded, -1);
+	if (index < 0 && JsonCompactKeysScope::active())
+	{
+		it = m_autoExact.constFind(key);
+		if (it != m_autoExact.constEnd())
+		{
+			return it.value();
+		}
+		index = m_autoFolded.value(folded, -1);
+	}
+	return index;
+}
+
+inline int JsonPropertyTable::indexAt(int *order, int position, const QString &key) const
+{
+	if (!order || position >= m_entries.size())
+	{
+		return indexOf(key);
+	}
+	int predicted = order[position];
+	if (predicted >= 0)
+	{
+		const Entry &entry = m_entries.at(predicted);
+		if (key == entry.name || (key == entry.alias && (!entry.autoAlias || JsonCompactKeysScope::active())))
+		{
+			return predicted;
+		}
+	}
+	int index = indexOf(key);
+	if (index >= 0)
+	{
+		order[position] = index;
+	}
+	return index;
+}
+
+inline const QString &JsonPropertyTable::key(int index) const
+{
+	const Entry &entry = m_entries.at(index);
+	return JsonCompactKeysScope::active() ? entry.alias : entry.name;
+}
+
+inline void JsonPropertyTable::write(JsonWriter &writer, const void *gadget) const
+{
+	const bool compact = JsonCompactKeysScope::active();
+	writer.beginObject();
+	for (int index : compact ? m_aliasOrder : m_nameOrder)
+	{
+		const Entry &entry = m_entries.at(index);
+		writer.writeQuotedKey(compact ? entry.quotedAlias : entry.quotedName);
+		if (const JsonFieldAccess *access = fieldAccess(index))
+		{
+			access->write(writer, gadget);
+		}
+		else
+		{
+			writer.writeValue(entry.property.readOnGadget(gadget).toJsonValue());
+		}
+	}
+	writer.endObject();
+}
+
+/**
+ * @brief 对象的可恢复编码帧：第一步写 '{'，之后每步写一个属性，最后一步写 '}'
+ */
+class JsonPropertyTable::ObjectFrame final : public JsonEncodeFrame
+{
+public:
+	ObjectFrame(const JsonPropertyTable &table, const void *gadget)
+		: m_table(table), m_gadget(gadget), m_compact(JsonCompactKeysScope::active())
+	{
+	}
+
+	bool step(JsonWriter &writer, std::unique_ptr<JsonEncodeFrame> &child) override
+	{
+		const QVector<int> &order = m_compact ? m_table.m_aliasOrder : m_table.m_nameOrder;
+		if (m_position < 0)
+		{
+			writer.beginObject();
+			m_position = 0;
+			return false;
+		}
+		if (m_position == order.size())
+		{
+			writer.endObject();
+			return true;
+		}
+		const int index = order.at(m_position++);
+		const Entry &entry = m_table.m_entries.at(index);
+		writer.writeQuotedKey(m_compact ? entry.quotedAlias : entry.quotedName);
+		if (const JsonFieldAccess *access = m_table.fieldAccess(index))
+		{
+			child = access->encodeFrame(m_gadget);
+			if (!child)
+			{
+				access->write(writer, m_gadget);
+			}
+		}
+		else
+		{
+			writer.writeValue(entry.property.readOnGadget(m_gadget).toJsonValue());
+		}
+		return false;
+	}
+
+private:
+	const JsonPropertyTable &m_table;
+	const void *m_gadget;
+	const bool m_compact;
+	int m_position = -1;
+};
+
+inline std::unique_ptr<JsonEncodeFrame> JsonPropertyTable::encodeFrame(const void *gadget) const
+{
+	return std::unique_ptr<JsonEncodeFrame>(new ObjectFrame(*this, gadget));
+}
+
+inline QJsonObject JsonPropertyTable::diff(const void *before, const void *after) const
+{
+	QJsonObject patch;
+	for (int i = 0; i < m_entries.size(); i++)
+	{
+		QJsonValue value;
+		if (const JsonFieldAccess *access = fieldAccess(i))
+		{
+			if (!access->diff(before, after, value))
+			{
+				continue;
+			}
+		}
+		else
+		{
+			const QMetaProperty &property = m_entries.at(i).property;
+			value = property.readOnGadget(after).toJsonValue();
+			if (property.readOnGadget(before).toJsonValue() == value)
+			{
+				continue;
+			}
+		}
+		patch.insert(key(i), value);
+	}
+	return patch;
+}
+
+inline void JsonPropertyTable::patch(void *gadget, const QJsonObject &patch) const
+{
+	// 补丁只含部分属性，键序列与完整文档不同，不参与键序推测
+	for (auto it = patch.constBegin(); it != patch.constEnd(); ++it)
+	{
+		int index = indexOf(it.key());
+		if (index < 0)
+		{
+			continue;
+		}
+		if (const JsonFieldAccess *access = fieldAccess(index))
+		{
+			access->patch(gadget, it.value());
+		}
+		else
+		{
+			m_entries.at(index).property.writeOnGadget(gadget, it.value());
+		}
+	}
+}
+
+inline void JsonPropertyTable::assign(void *gadget, const QJsonValue &val) const
+{
+	QVarLengthArray<bool, 64> present(m_entries.size());
+	for (int i = 0; i < present.size(); i++)
+	{
+		present[i] = false;
+	}
+	const QJsonObject json = val.toObject();
+	int *order = json.size() > 1 ? keyOrder() : nullptr;
+	int position = 0;
+	for (auto it = json.constBegin(); it != json.constEnd(); ++it)
+	{
+		int index = indexAt(order, position++, it.key());
+		if (index < 0)
+		{
+			continue;
+		}
+		present[index] = true;
+		if (const JsonFieldAccess *access = fieldAccess(index))
+		{
+			access->assign(gadget, it.value());
+		}
+		else
+		{
+			m_entries.at(index).property.writeOnGadget(gadget, it.value());
+		}
+	}
+	for (int i = 0; i < m_entries.size(); i++)
+	{
+		if (present[i])
+		{
+			continue;
+		}
+		if (const JsonFieldAccess *access = fieldAccess(i))
+		{
+			access->reset(gadget);
+		}
+		else
+		{
+			m_entries.at(i).property.writeOnGadget(gadget, QJsonValue());
+		}
+	}
+}
+
+inline QJsonObject JsonPropertyTable::toJson(const void *gadget) const
+{
+	if (const GeneratedCodec *generated = m_generated.load(std::memory_order_acquire))
+	{
+		return generated->toJson(gadget);
+	}
+	QJsonObject json;
+	for (int i = 0; i < m_entries.size(); i++)
+	{
+		json.insert(key(i), m_entries.at(i).property.readOnGadget(gadget).toJsonValue());
+	}
+	return json;
+}
+
+/**
+ * @brief JSON 可序列化标记宏
+ * @details 为类添加元对象支持，简化元对象方法的实现，并为类生成静态的 JSON 属性表
+ */
+#define JSON_SERIALIZABLE                                                   \
+	virtual const QMetaObject *metaObject() const                           \
+	{                                                                       \
+                                                                            \
+		return &this->staticMetaObject;                                     \
+	}                                                                       \
+                                                                            \
+protected:                                                                  \
+	virtual const JsonPropertyTable &jsonPropertyTable() const              \
+	{                                                                       \
+		using Self = std::remove_cv_t<std::remove_pointer_t<decltype(this)>>; \
+		return JsonPropertyTable::of<Self>();                               \
+	}                                                                       \
+                                                                            \
+private:
+
+/**
+ * @brief 可序列化基类
+ * @details 提供通用的 JSON 序列化和反序列化方法
+ * 子类需要实现 metaObject() 方法
+ */
+class JsonSerializable
+{
+	Q_GADGET
+public:
+	virtual ~JsonSerializable() = default;
+	/**
+	 * @brief 将 QJsonValue 转换为 JSON 字节数组
+	 * @param value 待转换的 JSON 值
+	 * @return QByteArray JSON 的字节数组表示
+	 */
+	static QByteArray toByteArray(const QJsonValue &value)
+	{
+		return QJsonDocument(value.toObject()).toJson();
+	}
+	
+	/**
+	 * @brief 序列化对象的所有 JSON 属性
+	 * @details 以下四个输出函数均为虚函数，派生类（如 JsonCachedSerializable）可以整体替换输出方式
+	 * @return QJsonObject 包含对象属性的 JSON 对象
+	 */
+	virtual QJsonObject toJson() const
+	{
+		return jsonPropertyTable().toJson(this);
+	}
+
+	/**
+	 * @brief 返回对象的 JSON 原始字节数据
+	 * @return QByteArray JSON 的原始字节数据
+	 */
+	virtual QByteArray toRawJson() const
+	{
+		return toByteArray(toJson());
+	}
+
+	/**
+	 * @brief 将对象写入写入器
+	 * @details 按 const 引用读取成员，不修改共享数据的引用计数
+	 * @param writer 写入器
+	 */
+	virtual void writeJson(JsonWriter &writer) const
+	{
+		jsonPropertyTable().write(writer, this);
+	}
+
+	/**
+	 * @brief 返回对象的紧凑 JSON 字节数据
+	 * @details 由 JsonWriter 直接生成，与 QJsonDocument::Compact 的输出一致
+	 * @return QByteArray 紧凑 JSON 的字节数据
+	 */
+	virtual QByteArray toCompactJson() const
+	{
+		QByteArray buffer;
+		JsonWriter writer(buffer);
+		writeJson(writer);
+		return buffer;
+	}
+
+	/**
+	 * @brief 创建对象的可恢复编码帧，见 JsonPropertyTable::encodeFrame()
+	 */
+	std::unique_ptr<JsonEncodeFrame> jsonEncodeFrame() const
+	{
+		return jsonPropertyTable().encodeFrame(this);
+	}
+
+	/**
+	 * @brief 生成从本对象到 other 的合并补丁，见 JsonPropertyTable::diff()
+	 * @details 两个对象的实际类型不同时返回 other 的完整 JSON
+	 * @param other 修改后的对象
+	 * @return QJsonObject 合并补丁
+	 */
+	QJsonObject diffJson(const JsonSerializable &other) const
+	{
+		if (metaObject() != other.metaObject())
+		{
+			return other.toJson();
+		}
+		return jsonPropertyTable().diff(this, &other);
+	}
+
+	/**
+	 * @brief 原地应用合并补丁，见 JsonPropertyTable::patch()
+	 * @param patch 合并补丁
+	 */
+	void applyJsonPatch(const QJsonObject &patch)
+	{
+		jsonPropertyTable().patch(this, patch);
+	}
+
+	/**
+	 * @brief 以 JSON 值覆盖对象，沿用成员原有的存储，见 JsonPropertyTable::assign()
+	 * @param val 包含属性的 JSON 值
+	 */
+	void overwriteFromJson(const QJsonValue &val)
+	{
+		jsonPropertyTable().assign(this, val);
+	}
+
+	/**
+	 * @brief 以 JSON 字节数组覆盖对象
+	 * @param data JSON 的字节数组
+	 */
+	void overwriteFromJson(const QByteArray &data)
+	{
+		overwriteFromJson(QJsonDocument::fromJson(data).object());
+	}
+
+	/**
+	 * @brief 从 JSON 值反序列化对象属性
+	 * @param val 包含属性的 JSON 值
+	 */
+	void fromJson(const QJsonValue &val)
+	{
+		jsonPropertyTable().fromJson(this, val);
+	}
+	
+	/**
+	 * @brief 从 JSON 字节数组反序列化对象
+	 * @param data JSON 的字节数组
+	 */
+	void fromJson(const QByteArray &data)
+	{
+		fromJson(QJsonDocument::fromJson(data).object());
+	}
+
+	/**
+	 * @brief 返回对象实际类型的类名
+	 * @details 由虚函数 metaObject() 决定，通过基类引用调用时得到的是派生类的类名
+	 * @return const char* 类名
+	 */
+	const char *jsonTypeName() const
+	{
+		return metaObject()->className();
+	}
+
+protected:
+	virtual const QMetaObject *metaObject() const = 0;
+
+	/**
+	 * @brief 返回对象实际类型的 JSON 属性表
+	 * @details JSON_SERIALIZABLE 会覆盖为类的静态属性表，默认实现按元对象查找缓存
+	 */
+	virtual const JsonPropertyTable &jsonPropertyTable() const
+	{
+		return JsonPropertyTable::of(metaObject());
+	}
+};
+
+/**
+ * @brief 静态分派的可序列化基类（CRTP）
+ * @tparam Derived 派生类，需要声明 Q_GADGET 并使用 JSON_PROPERTY 声明属性
+ * @details
+ * 提供与 JsonSerializable 相同的序列化接口，但没有虚函数：
+ * 对象不含虚表指针，元对象与属性表在编译期按 Derived 确定，调用可以内联
+ * 派生类不使用 JSON_SERIALIZABLE，也不支持通过基类指针的多态序列化
+ * 属性的读写仍经由 moc 生成的元对象调用
+ * @code
+ * class TestPoint final : public JsonSerializableT<TestPoint>
+ * {
+ *     Q_GADGET
+ * public:
+ *     JSON_PROPERTY(int, x)
+ *     JSON_PROPERTY(int, y)
+ * };
+ * @endcode
+ */
+template <typename Derived>
+class JsonSerializableT
+{
+public:
+	/**
+	 * @brief 返回 Derived 的 JSON 属性表
+	 */
+	static const JsonPropertyTable &staticJsonPropertyTable()
+	{
+		return JsonPropertyTable::of<Derived>();
+	}
+
+	/**
+	 * @brief 序列化对象的所有 JSON 属性
+	 * @return QJsonObject 包含对象属性的 JSON 对象
+	 */
+	QJsonObject toJson() const
+	{
+		return staticJsonPropertyTable().toJson(static_cast<const Derived *>(this));
+	}
+
+	/**
+	 * @brief 返回对象的 JSON 原始字节数据
+	 * @return QByteArray JSON 的原始字节数据
+	 */
+	QByteArray toRawJson() const
+	{
+		return JsonSerializable::toByteArray(toJson());
+	}
+
+	/**
+	 * @brief 将对象写入写入器
+	 * @param writer 写入器
+	 */
+	void writeJson(JsonWriter &writer) const
+	{
+		staticJsonPropertyTable().write(writer, static_cast<const Derived *>(this));
+	}
+
+	/**
+	 * @brief 返回对象的紧凑 JSON 字节数据
+	 * @return QByteArray 紧凑 JSON 的字节数据
+	 */
+	QByteArray toCompactJson() const
+	{
+		QByteArray buffer;
+		JsonWriter writer(buffer);
+		writeJson(writer);
+		return buffer;
+	}
+
+	/**
+	 * @brief 创建对象的可恢复编码帧，见 JsonPropertyTable::encodeFrame()
+	 */
+	std::unique_ptr<JsonEncodeFrame> jsonEncodeFrame() const
+	{
+		return staticJsonPropertyTable().encodeFrame(static_cast<const Derived *>(this));
+	}
+
+	/**
+	 * @brief 生成从本对象到 other 的合并补丁，见 JsonPropertyTable::diff()
+	 * @param other 修改后的对象
+	 * @return QJsonObject 合并补丁
+	 */
+	QJsonObject diffJson(const Derived &other) const
+	{
+		return staticJsonPropertyTable().diff(static_cast<const Derived *>(this), &other);
+	}
+
+	/**
+	 * @brief 原地应用合并补丁，见 JsonPropertyTable::patch()
+	 * @param patch 合并补丁
+	 */
+	void applyJsonPatch(const QJsonObject &patch)
+	{
+		staticJsonPropertyTable().patch(static_cast<Derived *>(this), patch);
+	}
+
+	/**
+	 * @brief 以 JSON 值覆盖对象，沿用成员原有的存储，见 JsonPropertyTable::assign()
+	 * @param val 包含属性的 JSON 值
+	 */
+	void overwriteFromJson(const QJsonValue &val)
+	{
+		staticJsonPropertyTable().assign(static_cast<Derived *>(this), val);
+	}
+
+	/**
+	 * @brief 以 JSON 字节数组覆盖对象
+	 * @param data JSON 的字节数组
+	 */
+	void overwriteFromJson(const QByteArray &data)
+	{
+		overwriteFromJson(QJsonDocument::fromJson(data).object());
+	}
+
+	/**
+	 * @brief 从 JSON 值反序列化对象属性
+	 * @param val 包含属性的 JSON 值
+	 */
+	void fromJson(const QJsonValue &val)
+	{
+		staticJsonPropertyTable().fromJson(static_cast<Derived *>(this), val);
+	}
+
+	/**
+	 * @brief 从 JSON 字节数组反序列化对象
+	 * @param data JSON 的字节数组
+	 */
+	void fromJson(const QByteArray &data)
+	{
+		fromJson(QJsonDocument::fromJson(data).object());
+	}
+
+	/**
+	 * @brief 返回对象类型的类名
+	 * @return const char* 类名
+	 */
+	const char *jsonTypeName() const
+	{
+		return Derived::staticMetaObject.className();
+	}
+
+protected:
+	~JsonSerializableT() = default;
+};
+
+/**
+ * @brief 缓存序列化结果的可序列化基类
+ * @details
+ * 用于反复序列化、很少修改的对象：序列化结果（QJsonObject、紧凑 JSON 与 toRawJson() 的输出）在首次生成后缓存，
+ * JSON_PROPERTY 的 setter 与 fromJson() 写入属性时清除缓存，未修改时直接返回缓存
+ * 嵌套的缓存对象及其容器在外层重新序列化时拼接各自的缓存片段，
+ * 一万个元素的列表只修改其中一个时，只有该元素与外层对象重新生成
+ * 缓存按生成时的短键名设置与浮点精度策略区分，设置不同时重新生成
+ * 以下情况不使用缓存，每次重新生成：
+ * - JsonReferenceScope 生效时，输出取决于作用域中已写出的对象
+ * - 类含有经由共享指针持有对象的属性（包括容器中的共享指针）时，被指向的对象可以不经外层的 setter 原地修改，
+ *   外层无法感知；类需使用 JSON_SERIALIZABLE，否则无法判断属性类型，同样不使用缓存
+ * 复制对象时共享缓存；多个线程可以同时序列化同一个未被修改的对象
+ * 缓存以原子的 std::shared_ptr 读写，对象不持有互斥锁；没有缓存时 setter 只读取一个原子标志，
+ * 不修改共享状态（C++20 标准库提供 std::atomic<std::shared_ptr> 时使用它，否则使用 std::atomic_load/std::atomic_store）
+ * 以其他方式修改成员后需调用 invalidateJsonCache()
+ * @code
+ * class CatalogEntry : public JsonCachedSerializable
+ * {
+ *     Q_GADGET
+ *     JSON_SERIALIZABLE
+ * public:
+ *     JSON_PROPERTY(QString, title)
+ * };
+ * @endcode
+ */
+class JsonCachedSerializable : public JsonSerializable
+{
+	Q_GADGET
+public:
+	JsonCachedSerializable() = default;
+
+	JsonCachedSerializable(const JsonCachedSerializable &other)
+		: JsonSerializable(other)
+	{
+		storeJsonCache(other.loadJsonCache());
+	}
+
+	JsonCachedSerializable &operator=(const JsonCachedSerializable &other)
+	{
+		if (this != &other)
+		{
+			JsonSerializable::operator=(other);
+			storeJsonCache(other.loadJsonCache());
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief 序列化对象的所有 JSON 属性，未修改时返回缓存
+	 */
+	QJsonObject toJson() const override;
+
+	/**
+	 * @brief 返回对象的 JSON 原始字节数据，未修改时返回缓存
+	 */
+	QByteArray toRawJson() const override;
+
+	/**
+	 * @brief 将对象写入写入器，未修改时拼接缓存的片段
+	 */
+	void writeJson(JsonWriter &writer) const override;
+
+	/**
+	 * @brief 返回对象的紧凑 JSON 字节数据，未修改时返回缓存
+	 */
+	QByteArray toCompactJson() const override;
+
+	/**
+	 * @brief 清除缓存的序列化结果
+	 * @details 由 JSON_PROPERTY 的 setter 自动调用
+	 */
+	void invalidateJsonCache()
+	{
+		if (m_jsonCached.load(std::memory_order_relaxed))
+		{
+			storeJsonCache(nullptr);
+		}
+	}
+
+private:
+	struct JsonCache
+	{
+		bool compact = false;
+		JsonFloatPrecision precision;
+		bool hasObject = false;
+		QJsonObject object;
+		QByteArray compactJson;
+		QByteArray rawJson;
+	};
+
+	/**
+	 * @brief 当前是否可以使用缓存，见类说明
+	 */
+	bool jsonCacheUsable() const;
+
+	std::shared_ptr<const JsonCache> loadJsonCache() const
+	{
+#if defined(__cpp_lib_atomic_shared_ptr)
+		return m_jsonCache.load(std::memory_order_acquire);
+#else
+		return std::atomic_load_explicit(&m_jsonCache, std::memory_order_acquire);
+#endif
+	}
+
+	void storeJsonCache(std::shared_ptr<const JsonCache> cache) const
+	{
+		// 修改与序列化不能并发进行，标志与缓存之间不需要更强的顺序
+		m_jsonCached.store(cache != nullptr, std::memory_order_relaxed);
+#if defined(__cpp_lib_atomic_shared_ptr)
+		m_jsonCache.store(std::move(cache), std::memory_order_release);
+#else
+		std::atomic_store_explicit(&m_jsonCache, std::move(cache), std::memory_order_release);
+#endif
+	}
+
+	/**
+	 * @brief 与当前线程的短键名设置、浮点精度策略一致的缓存，没有则返回空
+	 */
+	std::shared_ptr<const JsonCache> validJsonCache() const
+	{
+		std::shared_ptr<const JsonCache> cache = loadJsonCache();
+		if (cache && cache->compact == JsonCompactKeysScope::active() && cache->precision == JsonFloatPrecision::current())
+		{
+			return cache;
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief 在现有缓存的基础上补充一项并发布，缓存本身不可变
+	 */
+	template <typename Update>
+	void updateJsonCache(const std::shared_ptr<const JsonCache> &base, Update update) const
+	{
+		std::shared_ptr<JsonCache> next = base ? std::make_shared<JsonCache>(*base) : std::make_shared<JsonCache>();
+		next->compact = JsonCompactKeysScope::active();
+		next->precision = JsonFloatPrecision::current();
+		update(*next);
+		storeJsonCache(std::move(next));
+	}
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+	mutable std::atomic<std::shared_ptr<const JsonCache>> m_jsonCache;
+#else
+	mutable std::shared_ptr<const JsonCache> m_jsonCache;
+#endif
+	mutable std::atomic<bool> m_jsonCached{false}; ///< 是否可能持有缓存，供 setter 跳过没有缓存时的清除
+};
+
+/**
+ * @brief 清除对象序列化缓存的调用
+ * @details 对象提供 invalidateJsonCache()（如 JsonCachedSerializable）时调用，否则为空操作
+ */
+template <typename T, typename Enable = void>
+struct JsonDirtyTracking
+{
+	static void mark(T *object)
+	{
+		Q_UNUSED(object);
+	}
+};
+
+template <typename T>
+struct JsonDirtyTracking<T, decltype(static_cast<void>(std::declval<T &>().invalidateJsonCache()))>
+{
+	static void mark(T *object)
+	{
+		object->invalidateJsonCache();
+	}
+};
+
+/**
+ * @brief 判断类型是否为可序列化类（继承自 JsonSerializable 或 JsonSerializableT）
+ * @tparam T 待判断的类型
+ */
+template <typename T>
+struct IsJsonSerializable : std::integral_constant<bool, std::is_base_of<JsonSerializable, T>::value || std::is_base_of<JsonSerializableT<T>, T>::value>
+{
+};
+
+/**
+ * @brief 自定义类型（继承自 JsonSerializable 或 JsonSerializableT）的序列化器特化
+ * @tparam T 可序列化的自定义类型
+ * @details
+ * 针对可序列化类型提供特化的序列化和反序列化支持
+ * 调用对象的 toJson() 和 fromJson() 方法
+ */
+template <typename T>
+struct Serializer<T, typename std::enable_if<IsJsonSerializable<T>::value>::type>
+{
+	/**
+	 * @brief 将自定义对象转换为 QJsonValue
+	 * @param value 待序列化的对象
+	 * @return QJsonValue 转换后的 JSON 值
+	 */
+	static QJsonValue toJson(const T &value)
+	{
+		return value.toJson();
+	}
+
+	/**
+	 * @brief 从 QJsonValue 还原为自定义对象
+	 * @param json JSON 值
+	 * @return T 还原后的自定义对象
+	 */
+	static T fromJson(const QJsonValue &json)
+	{
+		T result;
+		result.fromJson(json.toObject());
+		return result;
+	}
+};
+
+/**
+ * @brief 多态类型注册表
+ * @tparam Base 多态层次的基类（继承自 JsonSerializable）
+ * @details
+ * 以类名为键保存派生类的工厂函数，注册在静态初始化阶段完成，之后只读
+ * 通过 Base 的共享指针序列化时会输出 "$type" 字段，反序列化时按该字段查表，
+ * 一次性创建具体类型并直接填充其属性
+ * 使用 JSON_REGISTER_TYPE(Base, Derived) 注册派生类
+ */
+template <typename Base>
+class JsonTypeRegistry
+{
+public:
+	using Factory = Base *(*)();
+
+	/**
+	 * @brief 类型鉴别字段的名称
+	 */
+	static QString discriminator()
+	{
+		return QStringLiteral("$type");
+	}
+
+	/**
+	 * @brief 注册派生类
+	 * @tparam Derived 派生类型，需要 Q_GADGET 以提供类名
+	 * @return bool 恒为 true，便于在静态初始化中调用
+	 */
+	template <typename Derived>
+	static bool add()
+	{
+		static_assert(std::is_base_of<Base, Derived>::value, "Derived must inherit from Base");
+		factories().insert(QString::fromLatin1(Derived::staticMetaObject.className()), &construct<Derived>);
+		return true;
+	}
+
+	/**
+	 * @brief 是否注册过派生类
+	 * @details 只有注册过派生类的基类才会在序列化时输出 "$type"
+	 */
+	static bool isEmpty()
+	{
+		return factories().isEmpty();
+	}
+
+	/**
+	 * @brief 按类名创建对象
+	 * @param typeName 类名
+	 * @return Base* 新建的对象，类名未注册时返回 nullptr
+	 */
+	static Base *create(const QString &typeName)
+	{
+		Factory factory = factories().value(typeName, nullptr);
+		return factory ? factory() : nullptr;
+	}
+
+private:
+	template <typename Derived>
+	static Base *construct()
+	{
+		return new Derived();
+	}
+
+	static QHash<QString, Factory> &factories()
+	{
+		static QHash<QString, Factory> table;
+		return table;
+	}
+};
+
+#define JSON_REGISTER_TYPE_CONCAT_(a, b) a##b
+#define JSON_REGISTER_TYPE_CONCAT(a, b) JSON_REGISTER_TYPE_CONCAT_(a, b)
+
+/**
+ * @brief 多态类型注册宏
+ * @details 在命名空间作用域中使用，将 Derived 注册到 Base 的类型注册表
+ * @param Base 多态层次的基类
+ * @param Derived 派生类
+ */
+#define JSON_REGISTER_TYPE(Base, Derived) \
+	static const bool JSON_REGISTER_TYPE_CONCAT(json_registered_type_, __LINE__) = JsonTypeRegistry<Base>::add<Derived>();
+
+/**
+ * @brief 生成的序列化代码登记器
+ * @tparam T 可序列化类，需在同一翻译单元中特化 JsonGeneratedCodec<T>
+ */
+template <typename T>
+struct JsonGeneratedRegistration
+{
+	/**
+	 * @brief 将 JsonGeneratedCodec<T> 登记到 T 的属性表
+	 * @return bool 恒为 true，便于在静态初始化中调用
+	 */
+	static bool add()
+	{
+		static const JsonPropertyTable::GeneratedCodec codec = {&toJson, &fromJson};
+		JsonPropertyTable::of<T>().setGeneratedCodec(&codec);
+		JsonPropertyTable::of(&T::staticMetaObject).setGeneratedCodec(&codec);
+		return true;
+	}
+
+private:
+	static QJsonObject toJson(const void *gadget)
+	{
+		return JsonGeneratedCodec<T>::toJson(*static_cast<const T *>(gadget));
+	}
+
+	static void fromJson(void *gadget, const QJsonValue &val)
+	{
+		JsonGeneratedCodec<T>::fromJson(*static_cast<T *>(gadget), val);
+	}
+};
+
+/**
+ * @brief 生成代码登记宏
+ * @details 由 JsonSerializerGen 写入生成的源文件，在命名空间作用域中使用
+ * 生成的源文件放在静态库中时，若没有其他符号被引用，链接器可能丢弃该目标文件而跳过登记，
+ * 此时应将其直接加入可执行文件或共享库的源文件列表
+ * @param Type 可序列化类
+ */
+#define JSON_REGISTER_GENERATED(Type) \
+	static const bool JSON_REGISTER_TYPE_CONCAT(json_registered_codec_, __LINE__) = JsonGeneratedRegistration<Type>::add();
+
+/**
+ * @brief 按静态类型创建对象的默认方式
+ * @tparam T 对象类型
+ * @details 抽象类型无法直接构造，返回 nullptr
+ */
+template <typename T, bool Abstract = std::is_abstract<T>::value>
+struct JsonDefaultInstance
+{
+	static T *create()
+	{
+		return new T();
+	}
+};
+
+template <typename T>
+struct JsonDefaultInstance<T, true>
+{
+	static T *create()
+	{
+		return nullptr;
+	}
+};
+
+/**
+ * @brief 共享指针的引用跟踪作用域
+ * @details
+ * 作用域存续期间，当前线程内序列化的共享对象只完整输出一次并附带 "$id"，
+ * 之后对同一对象的引用输出为 {"$ref": id}；反序列化时按 id 还原为同一个共享指针
+ * 只有序列化为 JSON 对象的值带有 "$id"，其他形式的值（字符串、数组等）始终按值输出
+ * 反序列化按 JSON 对象的键序（升序）进行，与输出时分配 id 的顺序无关：
+ * 引用出现在定义之前时先创建占位对象，读到带 "$id" 的定义时在占位对象上就地还原
+ * 作用域之外共享指针按值完整序列化，每个引用都会得到独立的副本
+ * 序列化期间被引用的对象必须保持存活，作用域以对象地址识别同一对象
+ * @code
+ * JsonReferenceScope scope;
+ * auto rawJson = catalog.toRawJson();
+ * @endcode
+ */
+class JsonReferenceScope
+{
+public:
+	JsonReferenceScope()
+		: m_previous(current())
+	{
+		current() = this;
+	}
+
+	~JsonReferenceScope()
+	{
+		current() = m_previous;
+	}
+
+	JsonReferenceScope(const JsonReferenceScope &) = delete;
+	JsonReferenceScope &operator=(const JsonReferenceScope &) = delete;
+
+	/**
+	 * @brief 当前线程上生效的作用域
+	 * @return JsonReferenceScope* 没有生效的作用域时返回 nullptr
+	 */
+	static JsonReferenceScope *active()
+	{
+		return current();
+	}
+
+	/**
+	 * @brief 查询对象是否已经输出过
+	 * @param object 对象地址
+	 * @return int 已分配的 id，尚未输出时返回 0
+	 */
+	int writtenId(const void *object) const
+	{
+		return m_written.value(object, 0);
+	}
+
+	/**
+	 * @brief 为即将输出的对象分配 id
+	 * @details 在序列化对象内容之前分配，使对象内部指回自身的引用也能写成 "$ref"
+	 * @param object 对象地址
+	 * @return int 新分配的 id（从 1 开始）
+	 */
+	int assignId(const void *object)
+	{
+		int id = ++m_lastId;
+		m_written.insert(object, id);
+		return id;
+	}
+
+	/**
+	 * @brief 撤销 assignId() 分配的 id
+	 * @details 值没有序列化为 JSON 对象、无法附带 "$id" 时调用，之后对同一对象的引用按值输出
+	 * @param object 对象地址
+	 */
+	void releaseId(const void *object)
+	{
+		m_written.remove(object);
+	}
+
+	/**
+	 * @brief 记录反序列化得到的共享指针
+	 * @tparam Pointer 共享指针类型
+	 * @param id JSON 中的 "$id"
+	 * @param pointer 对应的共享指针
+	 */
+	template <typename Pointer>
+	void remember(int id, const Pointer &pointer)
+	{
+		m_read.insert(id, Entry{std::make_shared<Pointer>(pointer), &typeid(Pointer), false});
+	}
+
+	/**
+	 * @brief 记录引用在定义之前出现时创建的占位对象
+	 * @details 之后读到同一 id 的定义时由 claim() 取回，在占位对象上还原内容
+	 * @tparam Pointer 共享指针类型
+	 * @param id JSON 中的 "$ref"
+	 * @param placeholder 占位对象
+	 */
+	template <typename Pointer>
+	void expect(int id, const Pointer &placeholder)
+	{
+		m_read.insert(id, Entry{std::make_shared<Pointer>(placeholder), &typeid(Pointer), true});
+	}
+
+	/**
+	 * @brief 取回 id 对应的占位对象
+	 * @tparam Pointer 共享指针类型
+	 * @param id JSON 中的 "$id"
+	 * @return Pointer 尚未还原且类型相同的占位对象，没有时返回空指针
+	 */
+	template <typename Pointer>
+	Pointer claim(int id)
+	{
+		auto it = m_read.find(id);
+		if (it == m_read.end() || !it->pending || *it->type != typeid(Pointer))
+		{
+			return Pointer();
+		}
+		it->pending = false;
+		return *std::static_pointer_cast<Pointer>(it->holder);
+	}
+
+	/**
+	 * @brief id 是否已经定义或已有占位对象
+	 * @param id JSON 中的 "$ref"
+	 */
+	bool contains(int id) const
+	{
+		return m_read.contains(id);
+	}
+
+	/**
+	 * @brief 按 "$ref" 查找已反序列化的共享指针
+	 * @tparam Pointer 共享指针类型
+	 * @param id JSON 中的 "$ref"
+	 * @return Pointer 对应的共享指针；未知 id，或该 id 以另一种指针类型记录时返回空指针
+	 */
+	template <typename Pointer>
+	Pointer resolve(int id) const
+	{
+		auto it = m_read.constFind(id);
+		if (it == m_read.constEnd() || *it->type != typeid(Pointer))
+		{
+			return Pointer();
+		}
+		return *std::static_pointer_cast<Pointer>(it->holder);
+	}
+
+private:
+	static JsonReferenceScope *&current()
+	{
+		static thread_local JsonReferenceScope *scope = nullptr;
+		return scope;
+	}
+
+	/**
+	 * @brief 反序列化时记录的共享指针，连同其类型，避免以另一种指针类型取回
+	 */
+	struct Entry
+	{
+		std::shared_ptr<void> holder;
+		const std::type_info *type;
+		bool pending;
+	};
+
+	JsonReferenceScope *m_previous;
+	int m_lastId = 0;
+	QHash<const void *, int> m_written;
+	QHash<int, Entry> m_read;
+};
+
+inline bool JsonCachedSerializable::jsonCacheUsable() const
+{
+	return !JsonReferenceScope::active() && !jsonPropertyTable().hasSharedMembers();
+}
+
+inline QJsonObject JsonCachedSerializable::toJson() const
+{
+	if (!jsonCacheUsable())
+	{
+		return JsonSerializable::toJson();
+	}
+	std::shared_ptr<const JsonCache> cache = validJsonCache();
+	if (cache && cache->hasObject)
+	{
+		return cache->object;
+	}
+	QJsonObject object = JsonSerializable::toJson();
+	updateJsonCache(cache, [&object](JsonCache &next) {
+		next.object = object;
+		next.hasObject = true;
+	});
+	return object;
+}
+
+inline QByteArray JsonCachedSerializable::toRawJson() const
+{
+	if (!jsonCacheUsable())
+	{
+		return JsonSerializable::toRawJson();
+	}
+	std::shared_ptr<const JsonCache> cache = validJsonCache();
+	if (cache && !cache->rawJson.isNull())
+	{
+		return cache->rawJson;
+	}
+	QByteArray json = toByteArray(toJson());
+	updateJsonCache(validJsonCache(), [&json](JsonCache &next) { next.rawJson = json; });
+	return json;
+}
+
+inline void JsonCachedSerializable::writeJson(JsonWriter &writer) const
+{
+	if (!jsonCacheUsable())
+	{
+		JsonSerializable::writeJson(writer);
+		return;
+	}
+	writer.writeRaw(toCompactJson());
+}
+
+inline QByteArray JsonCachedSerializable::toCompactJson() const
+{
+	if (!jsonCacheUsable())
+	{
+		return JsonSerializable::toCompactJson();
+	}
+	std::shared_ptr<const JsonCache> cache = validJsonCache();
+	if (cache && !cache->compactJson.isNull())
+	{
+		return cache->compactJson;
+	}
+	QByteArray json;
+	JsonWriter writer(json);
+	JsonSerializable::writeJson(writer);
+	updateJsonCache(cache, [&json](JsonCache &next) { next.compactJson = json; });
+	return json;
+}
+
+/**
+ * @brief 共享指针类型的统一访问接口
+ * @tparam Pointer 共享指针类型（std::shared_ptr 或 QSharedPointer）
+ */
+template <typename Pointer>
+struct JsonPointerTraits;
+
+template <typename T>
+struct JsonPointerTraits<std::shared_ptr<T>>
+{
+	using element_type = T;
+
+	static T *get(const std::shared_ptr<T> &pointer)
+	{
+		return pointer.get();
+	}
+
+	static std::shared_ptr<T> create()
+	{
+		return std::make_shared<T>();
+	}
+
+	static std::shared_ptr<T> adopt(T *object)
+	{
+		return std::shared_ptr<T>(object);
+	}
+};
+
+template <typename T>
+struct JsonPointerTraits<QSharedPointer<T>>
+{
+	using element_type = T;
+
+	static T *get(const QSharedPointer<T> &pointer)
+	{
+		return pointer.data();
+	}
+
+	static QSharedPointer<T> create()
+	{
+		return QSharedPointer<T>::create();
+	}
+
+	static QSharedPointer<T> adopt(T *object)
+	{
+		return QSharedPointer<T>(object);
+	}
+};
+
+/**
+ * @brief 共享指针序列化器的公共实现
+ * @tparam Pointer 共享指针类型
+ * @details
+ * 空指针序列化为 null，非空指针序列化为所指对象
+ * 在 JsonReferenceScope 中，对象形式的值会附带 "$id"，重复引用写为 {"$ref": id}
+ * 所指类型继承自 JsonSerializable 且在 JsonTypeRegistry 中注册过派生类时，
+ * 按对象的实际类型输出并附带 "$type"，反序列化时直接创建并填充对应的派生类；
+ * 此时 "$ref" 同样附带 "$type"，引用先于定义读到时据此创建正确类型的占位对象
+ */
+template <typename Pointer>
+struct JsonSharedPointerSerializer
+{
+	using Traits = JsonPointerTraits<Pointer>;
+	using T = typename Traits::element_type;
+	using Polymorphic = std::is_base_of<JsonSerializable, T>;
+
+	/**
+	 * @brief 将共享指针转换为 QJsonValue
+	 * @param pointer 待序列化的共享指针
+	 * @return QJsonValue 对象本身、"$ref" 引用或 null
+	 */
+	static QJsonValue toJson(const Pointer &pointer)
+	{
+		const T *object = Traits::get(pointer);
+		if (!object)
+		{
+			return QJsonValue();
+		}
+
+		JsonReferenceScope *scope = JsonReferenceScope::active();
+		if (!scope)
+		{
+			return encode(*object);
+		}
+
+		if (int id = scope->writtenId(object))
+		{
+			QJsonObject ref;
+			ref.insert(QStringLiteral("$ref"), id);
+			if constexpr (Polymorphic::value)
+			{
+				if (!JsonTypeRegistry<T>::isEmpty())
+				{
+					ref.insert(JsonTypeRegistry<T>::discriminator(), QString::fromLatin1(object->jsonTypeName()));
+				}
+			}
+			return ref;
+		}
+
+		int id = scope->assignId(object);
+		QJsonValue json = encode(*object);
+		if (!json.isObject())
+		{
+			// 无法附带 "$id"，之后的引用也按值输出
+			scope->releaseId(object);
+			return json;
+		}
+		QJsonObject obj = json.toObject();
+		obj.insert(QStringLiteral("$id"), id);
+		return obj;
+	}
+
+	/**
+	 * @brief 从 QJsonValue 还原为共享指针
+	 * @param json JSON 值
+	 * @return Pointer 还原后的共享指针，null 还原为空指针
+	 */
+	static Pointer fromJson(const QJsonValue &json)
+	{
+		if (json.isNull() || json.isUndefined())
+		{
+			return Pointer();
+		}
+
+		JsonReferenceScope *scope = JsonReferenceScope::active();
+		if (scope && json.isObject())
+		{
+			QJsonObject obj = json.toObject();
+			auto ref = obj.constFind(QStringLiteral("$ref"));
+			if (ref != obj.constEnd())
+			{
+				const int id = ref.value().toInt();
+				if (scope->contains(id))
+				{
+					return scope->template resolve<Pointer>(id);
+				}
+				// 定义在后面（例如键序靠后的属性中），先交出占位对象，读到定义时在其上还原
+				Pointer placeholder = instantiate(json);
+				if (placeholder)
+				{
+					scope->expect(id, placeholder);
+				}
+				return placeholder;
+			}
+			auto id = obj.constFind(QStringLiteral("$id"));
+			Pointer pointer;
+			if (id != obj.constEnd())
+			{
+				pointer = scope->template claim<Pointer>(id.value().toInt());
+				if (pointer && !matchesType(pointer, json))
+				{
+					pointer = Pointer();
+				}
+			}
+			if (!pointer)
+			{
+				pointer = instantiate(json);
+				if (pointer && id != obj.constEnd())
+				{
+					// 先登记再还原内容，对象内部指回自身的 "$ref" 才能解析到同一指针
+					scope->remember(id.value().toInt(), pointer);
+				}
+			}
+			decode(pointer, json);
+			return pointer;
+		}
+
+		Pointer pointer = instantiate(json);
+		decode(pointer, json);
+		return pointer;
+	}
+
+private:
+	static QJsonValue encode(const T &object)
+	{
+		if constexpr (Polymorphic::value)
+		{
+			QJsonObject json = object.toJson();
+			if (!JsonTypeRegistry<T>::isEmpty())
+			{
+				json.insert(JsonTypeRegistry<T>::discriminator(), QString::fromLatin1(object.jsonTypeName()));
+			}
+			return json;
+		}
+		else
+		{
+			return Serializer<T>::toJson(object);
+		}
+	}
+
+	static Pointer instantiate(const QJsonValue &json)
+	{
+		if constexpr (Polymorphic::value)
+		{
+			T *object = nullptr;
+			if (!JsonTypeRegistry<T>::isEmpty())
+			{
+				object = JsonTypeRegistry<T>::create(json.toObject().value(JsonTypeRegistry<T>::discriminator()).toString());
+			}
+			if (!object)
+			{
+				object = JsonDefaultInstance<T>::create();
+			}
+			return object ? Traits::adopt(object) : Pointer();
+		}
+		else
+		{
+			Q_UNUSED(json);
+			return Traits::create();
+		}
+	}
+
+	/**
+	 * @brief 占位对象的实际类型是否与定义中的 "$type" 一致
+	 */
+	static bool matchesType(const Pointer &pointer, const QJsonValue &json)
+	{
+		if constexpr (Polymorphic::value)
+		{
+			if (!JsonTypeRegistry<T>::isEmpty())
+			{
+				const QJsonValue type = json.toObject().value(JsonTypeRegistry<T>::discriminator());
+				return type.isUndefined() || type.toString() == QLatin1String(Traits::get(pointer)->jsonTypeName());
+			}
+		}
+		else
+		{
+			Q_UNUSED(pointer);
+			Q_UNUSED(json);
+		}
+		return true;
+	}
+
+	static void decode(const Pointer &pointer, const QJsonValue &json)
+	{
+		if constexpr (Polymorphic::value)
+		{
+			// 虚函数 metaObject() 使属性按实际类型写入，无需再经过一次拷贝
+			if (T *object = Traits::get(pointer))
+			{
+				object->fromJson(json);
+			}
+		}
+		else
+		{
+			*Traits::get(pointer) = Serializer<T>::fromJson(json);
+		}
+	}
+};
+
+/**
+ * @brief std::shared_ptr 的序列化器特化
+ * @tparam T 所指对象的类型
+ */
+template <typename T>
+struct Serializer<std::shared_ptr<T>> : JsonSharedPointerSerializer<std::shared_ptr<T>>
+{
+};
+
+/**
+ * @brief QSharedPointer 的序列化器特化
+ * @tparam T 所指对象的类型
+ */
+template <typename T>
+struct Serializer<QSharedPointer<T>> : JsonSharedPointerSerializer<QSharedPointer<T>>
+{
+};
+
+/**
+ * @brief 指定浮点数输出精度的序列化器
+ * @tparam T 属性的数据类型（浮点数或其容器）
+ * @tparam Mode 精度模式
+ * @tparam Digits 小数位数或有效数字位数
+ * @details 在序列化该值期间覆盖当前线程的浮点数精度策略，反序列化与 Serializer<T> 相同
+ */
+template <typename T, JsonFloatPrecision::Mode Mode, int Digits>
+struct JsonPrecisionSerializer
+{
+	static QJsonValue toJson(const T &value)
+	{
+		JsonFloatPrecisionScope scope(JsonFloatPrecision(Mode, Digits));
+		return Serializer<T>::toJson(value);
+	}
+
+	static T fromJson(const QJsonValue &json)
+	{
+		return Serializer<T>::fromJson(json);
+	}
+};
+
+/**
+ * @brief 结构体字段描述
+ * @tparam Class 字段所属的类型
+ * @tparam Type 字段的数据类型
+ * @details 由 JSON_FIELDS 生成，保存字段名与成员指针
+ */
+template <typename Class, typename Type>
+struct JsonField
+{
+	using type = Type;
+
+	const char *name;
+	Type Class::*member;
+};
+
+/**
+ * @brief 判断类型是否通过 JSON_FIELDS 声明了字段列表
+ * @tparam T 待判断的类型
+ * @details 通过实参依赖查找 JSON_FIELDS 生成的 jsonFields(const T *) 函数
+ */
+template <typename T, typename Enable = void>
+struct HasJsonFields : std::false_type
+{
+};
+
+template <typename T>
+struct HasJsonFields<T, decltype(static_cast<void>(jsonFields(static_cast<const T *>(nullptr))))> : std::true_type
+{
+};
+
+/**
+ * @brief 通过 JSON_FIELDS 声明字段的普通结构体的序列化器特化
+ * @tparam T 声明了字段列表的类型
+ * @details
+ * 字段列表是编译期的成员指针元组，序列化逐字段展开为直接的成员访问与 Serializer<Field> 调用，
+ * 不需要继承 JsonSerializable、Q_GADGET 或 moc
+ * 键为字段名，读取时与 JsonSerializable 一样不区分大小写
+ */
+template <typename T>
+struct Serializer<T, typename std::enable_if<HasJsonFields<T>::value && !IsJsonSerializable<T>::value>::type>
+{
+	/**
+	 * @brief 将结构体转换为 QJsonObject
+	 * @param value 待序列化的结构体
+	 * @return QJsonValue 转换后的 JSON 对象
+	 */
+	static QJsonValue toJson(const T &value)
+	{
+		QJsonObject json;
+		const QStringList &names = keys();
+		int index = 0;
+		forEachField([&](const auto &field) {
+			using Field = typename std::decay<decltype(field)>::type;
+			json.insert(names.at(index++), Serializer<typename Field::type>::toJson(value.*field.member));
+		});
+		return json;
+	}
+
+	/**
+	 * @brief 从 QJsonObject 还原结构体
+	 * @param json JSON 对象值
+	 * @return T 还原后的结构体，缺少的字段保持默认值
+	 */
+	static T fromJson(const QJsonValue &json)
+	{
+		T result{};
+		if (!json.isObject())
+		{
+			return result;
+		}
+		QJsonObject obj = json.toObject();
+		const QStringList &names = keys();
+		int index = 0;
+		forEachField([&](const auto &field) {
+			using Field = typename std::decay<decltype(field)>::type;
+			const QString &name = names.at(index++);
+			auto it = obj.constFind(name);
+			if (it == obj.constEnd())
+			{
+				it = findCaseInsensitive(obj, name);
+			}
+			if (it != obj.constEnd())
+			{
+				result.*field.member = Serializer<typename Field::type>::fromJson(it.value());
+			}
+		});
+		return result;
+	}
+
+private:
+	template <typename, typename>
+	friend struct JsonWrite;
+	template <typename, typename>
+	friend struct JsonAssign;
+
+	using Fields = decltype(jsonFields(static_cast<const T *>(nullptr)));
+
+	static const Fields &fields()
+	{
+		static const Fields list = jsonFields(static_cast<const T *>(nullptr));
+		return list;
+	}
+
+	template <typename Visitor>
+	static void forEachField(Visitor &&visitor)
+	{
+		applyFields(visitor, std::make_index_sequence<std::tuple_size<Fields>::value>());
+	}
+
+	template <typename Visitor, std::size_t... Index>
+	static void applyFields(Visitor &visitor, std::index_sequence<Index...>)
+	{
+		static_cast<void>(std::initializer_list<int>{(visitor(std::get<Index>(fields())), 0)...});
+	}
+
+	static const QStringList &keys()
+	{
+		static const QStringList names = [] {
+			QStringList result;
+			forEachField([&](const auto &field) {
+				result.append(QString::fromLatin1(field.name));
+			});
+			return result;
+		}();
+		return names;
+	}
+
+	static QJsonObject::const_iterator findCaseInsensitive(const QJsonObject &obj, const QString &name)
+	{
+		for (auto it = obj.constBegin(); it != obj.constEnd(); ++it)
+		{
+			if (it.key().compare(name, Qt::CaseInsensitive) == 0)
+			{
+				return it;
+			}
+		}
+		return obj.constEnd();
+	}
+};
+
+#define JSON_FIELDS_EXPAND(x) x
+#define JSON_FIELDS_CONCAT_(a, b) a##b
+#define JSON_FIELDS_CONCAT(a, b) JSON_FIELDS_CONCAT_(a, b)
+#define JSON_FIELDS_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, N, ...) N
+#define JSON_FIELDS_COUNT(...) JSON_FIELDS_EXPAND(JSON_FIELDS_COUNT_(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define JSON_FIELDS_EACH_1(m, t, x) m(t, x)
+#define JSON_FIELDS_EACH_2(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_1(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_3(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_2(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_4(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_3(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_5(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_4(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_6(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_5(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_7(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_6(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_8(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_7(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_9(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_8(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_10(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_9(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_11(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_10(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_12(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_11(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_13(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_12(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_14(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_13(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_15(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_14(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_16(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_15(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_17(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_16(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_18(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_17(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_19(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_18(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_20(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_19(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_21(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_20(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_22(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_21(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_23(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_22(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_24(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_23(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_25(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_24(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_26(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_25(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_27(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_26(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_28(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_27(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_29(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_28(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_30(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_29(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_31(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_30(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH_32(m, t, x, ...) m(t, x), JSON_FIELDS_EXPAND(JSON_FIELDS_EACH_31(m, t, __VA_ARGS__))
+#define JSON_FIELDS_EACH(m, t, ...) JSON_FIELDS_EXPAND(JSON_FIELDS_CONCAT(JSON_FIELDS_EACH_, JSON_FIELDS_COUNT(__VA_ARGS__))(m, t, __VA_ARGS__))
+#define JSON_FIELDS_ENTRY(Type, field) JsonField<Type, decltype(Type::field)>{#field, &Type::field}
+
+/**
+ * @brief 普通结构体的字段列表声明宏
+ * @details
+ * 在结构体所在的命名空间中使用（结构体定义之后），为其生成编译期字段列表，
+ * 使其可以直接用于所有 Serializer 路径（容器、映射、共享指针、JSON_PROPERTY 等），无需 moc
+ * 最多支持 32 个字段，字段需为可访问的非静态数据成员
+ * @code
+ * struct TestSample { QString name; int value; };
+ * JSON_FIELDS(TestSample, name, value)
+ * @endcode
+ * @param Type 结构体类型
+ * @param ... 字段名列表
+ */
+#define JSON_FIELDS(Type, ...)                                                          \
+	inline auto jsonFields(const Type *)                                                \
+	{                                                                                   \
+		return std::make_tuple(JSON_FIELDS_EACH(JSON_FIELDS_ENTRY, Type, __VA_ARGS__)); \
+	}
+
+/**
+ * @brief 写入器的类型分派
+ * @tparam T 值的类型
+ * @tparam Enable 用于模板特化的 SFINAE 辅助类型
+ * @details
+ * 数值、字符串、序列容器、映射容器、可序列化类与 JSON_FIELDS 结构体按 const 引用直接写入，
+ * 其他类型经由 Serializer<T> 转换为 QJsonValue 后写入，输出与 Serializer<T> 一致
+ * 与 Serializer 一样，可以为新类型特化
+ */
+template <typename T, typename Enable = void>
+struct JsonWrite
+{
+	static void write(JsonWriter &writer, const T &value)
+	{
+		writer.writeValue(Serializer<T>::toJson(value));
+	}
+};
+
+template <typename T>
+inline void JsonWriter::write(const T &value)
+{
+	JsonWrite<T>::write(*this, value);
+}
+
+/**
+ * @brief 数值类型的直接写入，规则与 JsonNumber 相同
+ */
+template <typename T>
+struct JsonWrite<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+{
+	static void write(JsonWriter &writer, const T &value)
+	{
+		if constexpr (std::is_same<T, bool>::value)
+		{
+			writer.writeBool(value);
+		}
+		else if constexpr (std::is_integral<T>::value)
+		{
+			if constexpr (std::is_unsigned<T>::value && sizeof(T) >= sizeof(qint64))
+			{
+				if (value > static_cast<quint64>(std::numeric_limits<qint64>::max()))
+				{
+					writer.writeDouble(static_cast<double>(value));
+				}
+				else
+				{
+					writer.writeInteger(static_cast<qint64>(value));
+				}
+			}
+			else
+			{
+				writer.writeInteger(static_cast<qint64>(value));
+			}
+		}
+		else
+		{
+			writer.writeDouble(JsonFloatPrecision::current().apply(static_cast<double>(value)));
+		}
+	}
+};
+
+template <>
+struct JsonWrite<QString>
+{
+	static void write(JsonWriter &writer, const QString &value)
+	{
+		writer.writeString(value);
+	}
+};
+
+template <>
+struct JsonWrite<QJsonValue>
+{
+	static void write(JsonWriter &writer, const QJsonValue &value)
+	{
+		writer.writeValue(value);
+	}
+};
+
+/**
+ * @brief 序列容器的直接写入
+ * @details 通过 const 引用遍历，不会触发隐式共享容器的分离或引用计数变化
+ */
+template <typename Container>
+struct JsonWriteSequence
+{
+	static void write(JsonWriter &writer, const Container &value)
+	{
+		using Element = typename std::decay<decltype(*value.begin())>::type;
+		writer.beginArray();
+		for (const auto &item : value)
+		{
+			JsonWrite<Element>::write(writer, item);
+		}
+		writer.endArray();
+	}
+};
+
+template <template <typename> class Container, typename T>
+struct JsonWrite<Container<T>, typename std::enable_if<std::is_same<Container<T>, QList<T>>::value || std::is_same<Container<T>, QVector<T>>::value>::type>
+	: JsonWriteSequence<Container<T>>
+{
+};
+
+template <typename T>
+struct JsonWrite<std::vector<T>> : JsonWriteSequence<std::vector<T>>
+{
+};
+
+/**
+ * @brief 映射容器的直接写入
+ * @details
+ * 键经 KeyCodec 转换后按字符串升序输出，与 QJsonObject 的顺序一致；
+ * 以 QString 为键的有序映射本身已按该顺序排列，直接遍历
+ */
+template <typename Map, typename K, typename V>
+struct JsonWriteMap
+{
+	static void write(JsonWriter &writer, const Map &value)
+	{
+		writer.beginObject();
+		if constexpr (std::is_same<K, QString>::value && !std::is_same<Map, QHash<K, V>>::value)
+		{
+			for (auto it = value.begin(); it != value.end(); ++it)
+			{
+				writer.writeKey(key(it));
+				JsonWrite<V>::write(writer, mapped(it));
+			}
+		}
+		else
+		{
+			std::vector<std::pair<QString, const V *>> entries;
+			entries.reserve(value.size());
+			for (auto it = value.begin(); it != value.end(); ++it)
+			{
+				entries.emplace_back(KeyCodec<K>::toKey(key(it)), &mapped(it));
+			}
+			std::sort(entries.begin(), entries.end(), [](const std::pair<QString, const V *> &a, const std::pair<QString, const V *> &b) {
+				return a.first < b.first;
+			});
+			for (const auto &entry : entries)
+			{
+				writer.writeKey(entry.first);
+				JsonWrite<V>::write(writer, *entry.second);
+			}
+		}
+		writer.endObject();
+	}
+
+private:
+	template <typename Iterator>
+	static const K &key(const Iterator &it)
+	{
+		if constexpr (std::is_same<Map, std::map<K, V>>::value)
+		{
+			return it->first;
+		}
+		else
+		{
+			return it.key();
+		}
+	}
+
+	template <typename Iterator>
+	static const V &mapped(const Iterator &it)
+	{
+		if constexpr (std::is_same<Map, std::map<K, V>>::value)
+		{
+			return it->second;
+		}
+		else
+		{
+			return it.value();
+		}
+	}
+};
+
+template <template <typename, typename> class Map, typename K, typename V>
+struct JsonWrite<Map<K, V>, typename std::enable_if<std::is_same<Map<K, V>, QMap<K, V>>::value || std::is_same<Map<K, V>, QHash<K, V>>::value>::type>
+	: JsonWriteMap<Map<K, V>, K, V>
+{
+};
+
+template <typename K, typename V>
+struct JsonWrite<std::map<K, V>> : JsonWriteMap<std::map<K, V>, K, V>
+{
+};
+
+/**
+ * @brief 可序列化类的直接写入，经由类的 JSON 属性表按成员引用写入
+ */
+template <typename T>
+struct JsonWrite<T, typename std::enable_if<IsJsonSerializable<T>::value>::type>
+{
+	static void write(JsonWriter &writer, const T &value)
+	{
+		value.writeJson(writer);
+	}
+};
+
+/**
+ * @brief JSON_FIELDS 结构体的直接写入
+ * @details 每个字段对应一个写入函数，按键的升序调用
+ */
+template <typename T>
+struct JsonWrite<T, typename std::enable_if<HasJsonFields<T>::value && !IsJsonSerializable<T>::value>::type>
+{
+	static void write(JsonWriter &writer, const T &value)
+	{
+		static const auto writers = makeWriters(std::make_index_sequence<FieldCount>());
+		static const std::vector<std::pair<QByteArray, std::size_t>> keys = [] {
+			std::vector<std::pair<QString, std::size_t>> names;
+			const QStringList &fieldNames = Codec::keys();
+			for (int i = 0; i < fieldNames.size(); i++)
+			{
+				names.emplace_back(fieldNames.at(i), static_cast<std::size_t>(i));
+			}
+			std::sort(names.begin(), names.end());
+			std::vector<std::pair<QByteArray, std::size_t>> result;
+			for (const auto &name : names)
+			{
+				result.emplace_back(JsonWriter::quoted(name.first), name.second);
+			}
+			return result;
+		}();
+
+		writer.beginObject();
+		for (const auto &key : keys)
+		{
+			writer.writeQuotedKey(key.first);
+			writers[key.second](writer, value);
+		}
+		writer.endObject();
+	}
+
+private:
+	using Codec = Serializer<T>;
+	static constexpr std::size_t FieldCount = std::tuple_size<typename Codec::Fields>::value;
+	using FieldWriter = void (*)(JsonWriter &, const T &);
+
+	template <std::size_t Index>
+	static void writeField(JsonWriter &writer, const T &value)
+	{
+		const auto &field = std::get<Index>(Codec::fields());
+		using Field = typename std::decay<decltype(field)>::type;
+		JsonWrite<typename Field::type>::write(writer, value.*field.member);
+	}
+
+	template <std::size_t... Index>
+	static std::array<FieldWriter, FieldCount> makeWriters(std::index_sequence<Index...>)
+	{
+		return {{&writeField<Index>...}};
+	}
+};
+
+/**
+ * @brief 值的可恢复编码帧
+ * @tparam T 值的类型
+ * @details 可序列化类逐个属性展开，序列容器逐个元素展开；其余类型返回空，由 JsonWrite<T> 一次写出
+ */
+template <typename T, typename Enable = void>
+struct JsonEncodeFrameOf
+{
+	static std::unique_ptr<JsonEncodeFrame> create(const T &value)
+	{
+		Q_UNUSED(value);
+		return nullptr;
+	}
+};
+
+template <typename T>
+struct JsonEncodeFrameOf<T, typename std::enable_if<IsJsonSerializable<T>::value>::type>
+{
+	static std::unique_ptr<JsonEncodeFrame> create(const T &value)
+	{
+		return value.jsonEncodeFrame();
+	}
+};
+
+/**
+ * @brief 序列容器的可恢复编码帧：每步写一个元素
+ */
+template <typename Container>
+class JsonSequenceEncodeFrame final : public JsonEncodeFrame
+{
+public:
+	explicit JsonSequenceEncodeFrame(const Container &container)
+		: m_container(container), m_it(container.begin())
+	{
+	}
+
+	bool step(JsonWriter &writer, std::unique_ptr<JsonEncodeFrame> &child) override
+	{
+		using T = typename Container::value_type;
+		if (!m_started)
+		{
+			writer.beginArray();
+			m_started = true;
+			return false;
+		}
+		if (m_it == m_container.end())
+		{
+			writer.endArray();
+			return true;
+		}
+		const T &element = *m_it++;
+		child = JsonEncodeFrameOf<T>::create(element);
+		if (!child)
+		{
+			JsonWrite<T>::write(writer, element);
+		}
+		return false;
+	}
+
+private:
+	const Container &m_container;
+	typename Container::const_iterator m_it;
+	bool m_started = false;
+};
+
+template <template <typename> class Container, typename T>
+struct JsonEncodeFrameOf<Container<T>, typename std::enable_if<std::is_same<Container<T>, QList<T>>::value || std::is_same<Container<T>, QVector<T>>::value>::type>
+{
+	static std::unique_ptr<JsonEncodeFrame> create(const Container<T> &value)
+	{
+		return std::unique_ptr<JsonEncodeFrame>(new JsonSequenceEncodeFrame<Container<T>>(value));
+	}
+};
+
+template <typename T>
+struct JsonEncodeFrameOf<std::vector<T>>
+{
+	static std::unique_ptr<JsonEncodeFrame> create(const std::vector<T> &value)
+	{
+		return std::unique_ptr<JsonEncodeFrame>(new JsonSequenceEncodeFrame<std::vector<T>>(value));
+	}
+};
+
+/**
+ * @brief 可直接用 == 比较的类型
+ */
+template <typename T>
+struct JsonEqualityComparable : std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_same<T, QString>::value || std::is_same<T, QByteArray>::value || std::is_same<T, QUuid>::value>
+{
+};
+
+/**
+ * @brief 合并补丁的成员比较
+ * @tparam T 成员类型
+ * @details
+ * diff() 在值有变化时生成补丁值：可序列化类与映射输出嵌套补丁，其余类型（包括数组）输出修改后的完整值
+ * 可以用 == 比较的类型直接比较，其他类型比较 Serializer<T> 的输出
+ */
+template <typename T, typename Enable = void>
+struct JsonDiff
+{
+	static bool equal(const T &before, const T &after)
+	{
+		if constexpr (JsonEqualityComparable<T>::value)
+		{
+			return before == after;
+		}
+		else
+		{
+			return Serializer<T>::toJson(before) == Serializer<T>::toJson(after);
+		}
+	}
+
+	static bool diff(const T &before, const T &after, QJsonValue &patch)
+	{
+		if (equal(before, after))
+		{
+			return false;
+		}
+		patch = Serializer<T>::toJson(after);
+		return true;
+	}
+};
+
+template <typename T>
+struct JsonDiff<T, typename std::enable_if<IsJsonSerializable<T>::value>::type>
+{
+	static bool equal(const T &before, const T &after)
+	{
+		return before.diffJson(after).isEmpty();
+	}
+
+	static bool diff(const T &before, const T &after, QJsonValue &patch)
+	{
+		QJsonObject object = before.diffJson(after);
+		if (object.isEmpty())
+		{
+			return false;
+		}
+		patch = object;
+		return true;
+	}
+};
+
+/**
+ * @brief 序列容器的比较：逐个元素比较，有变化时整体替换（合并补丁不描述数组的局部修改）
+ */
+template <typename Container>
+struct JsonDiffSequence
+{
+	using T = typename Container::value_type;
+
+	static bool equal(const Container &before, const Container &after)
+	{
+		if (before.size() != after.size())
+		{
+			return false;
+		}
+		return std::equal(before.begin(), before.end(), after.begin(), [](const T &a, const T &b) { return JsonDiff<T>::equal(a, b); });
+	}
+
+	static bool diff(const Container &before, const Container &after, QJsonValue &patch)
+	{
+		if (equal(before, after))
+		{
+			return false;
+		}
+		patch = Serializer<Container>::toJson(after);
+		return true;
+	}
+};
+
+template <template <typename> class Container, typename T>
+struct JsonDiff<Container<T>, typename std::enable_if<std::is_same<Container<T>, QList<T>>::value || std::is_same<Container<T>, QVector<T>>::value>::type> : JsonDiffSequence<Container<T>>
+{
+};
+
+template <typename T>
+struct JsonDiff<std::vector<T>> : JsonDiffSequence<std::vector<T>>
+{
+};
+
+/**
+ * @brief 映射的比较：删除的键输出 null，新增的键输出完整值，共有的键递归比较
+ */
+template <typename Map, typename K, typename V>
+struct JsonDiffMap
+{
+	static bool equal(const Map &before, const Map &after)
+	{
+		QJsonValue patch;
+		return !diff(before, after, patch);
+	}
+
+	static bool diff(const Map &before, const Map &after, QJsonValue &patch)
+	{
+		QJsonObject object;
+		for (auto it = before.begin(); it != before.end(); ++it)
+		{
+			if (after.find(key(it)) == after.end())
+			{
+				object.insert(KeyCodec<K>::toKey(key(it)), QJsonValue::Null);
+			}
+		}
+		for (auto it = after.begin(); it != after.end(); ++it)
+		{
+			auto previous = before.find(key(it));
+			if (previous == before.end())
+			{
+				object.insert(KeyCodec<K>::toKey(key(it)), Serializer<V>::toJson(mapped(it)));
+				continue;
+			}
+			QJsonValue value;
+			if (JsonDiff<V>::diff(mapped(previous), mapped(it), value))
+			{
+				object.insert(KeyCodec<K>::toKey(key(it)), value);
+			}
+		}
+		if (object.isEmpty())
+		{
+			return false;
+		}
+		patch = object;
+		return true;
+	}
+
+private:
+	template <typename Iterator>
+	static const K &key(const Iterator &it)
+	{
+		if constexpr (std::is_same<Map, std::map<K, V>>::value)
+		{
+			return it->first;
+		}
+		else
+		{
+			return it.key();
+		}
+	}
+
+	template <typename Iterator>
+	static const V &mapped(const Iterator &it)
+	{
+		if constexpr (std::is_same<Map, std::map<K, V>>::value)
+		{
+			return it->second;
+		}
+		else
+		{
+			return it.value();
+		}
+	}
+};
+
+template <template <typename, typename> class Map, typename K, typename V>
+struct JsonDiff<Map<K, V>, typename std::enable_if<std::is_same<Map<K, V>, QMap<K, V>>::value || std::is_same<Map<K, V>, QHash<K, V>>::value>::type> : JsonDiffMap<Map<K, V>, K, V>
+{
+};
+
+template <typename K, typename V>
+struct JsonDiff<std::map<K, V>> : JsonDiffMap<std::map<K, V>, K, V>
+{
+};
+
+/**
+ * @brief 覆盖式解码
+ * @tparam T 值的类型
+ * @details
+ * assign() 之后 target 与 Serializer<T>::fromJson(json) 的结果相同，但尽量沿用 target 原有的存储：
+ * 可序列化类与 JSON_FIELDS 结构体逐个成员覆盖，缺少的成员恢复为默认值；
+ * 序列容器调整长度后逐个元素覆盖，std::vector 与 QVector 保留容量；映射删除多余的键后逐个覆盖
+ * 反复把同构的消息解码到同一个对象时，容器与嵌套对象在预热后不再重新分配
+ * 与 Serializer 一样，可以为新类型特化
+ */
+template <typename T, typename Enable = void>
+struct JsonAssign
+{
+	static void assign(T &target, const QJsonValue &json)
+	{
+		target = Serializer<T>::fromJson(json);
+	}
+};
+
+template <typename T>
+struct JsonAssign<T, typename std::enable_if<IsJsonSerializable<T>::value>::type>
+{
+	static void assign(T &target, const QJsonValue &json)
+	{
+		target.overwriteFromJson(json);
+	}
+};
+
+template <typename T>
+struct JsonAssign<T, typename std::enable_if<HasJsonFields<T>::value && !IsJsonSerializable<T>::value>::type>
+{
+	static void assign(T &target, const QJsonValue &json)
+	{
+		static const T defaults{};
+		const QJsonObject obj = json.toObject();
+		const QStringList &names = Codec::keys();
+		int index = 0;
+		Codec::forEachField([&](const auto &field) {
+			using Field = typename std::decay<decltype(field)>::type;
+			const QString &name = names.at(index++);
+			auto it = obj.constFind(name);
+			if (it == obj.constEnd())
+			{
+				it = Codec::findCaseInsensitive(obj, name);
+			}
+			if (it != obj.constEnd())
+			{
+				JsonAssign<typename Field::type>::assign(target.*field.member, it.value());
+			}
+			else
+			{
+				target.*field.member = defaults.*field.member;
+			}
+		});
+	}
+
+private:
+	using Codec = Serializer<T>;
+};
+
+/**
+ * @brief 序列容器的覆盖：调整长度后逐个元素覆盖
+ */
+template <typename Container>
+struct JsonAssignSequence
+{
+	using T = typename Container::value_type;
+
+	static void assign(Container &target, const QJsonValue &json)
+	{
+		const QJsonArray array = json.toArray();
+		resize(target, array.size());
+		int i = 0;
+		for (auto it = target.begin(); it != target.end(); ++it)
+		{
+			assignElement(*it, array.at(i++));
+		}
+	}
+
+	/**
+	 * @brief 覆盖单个元素
+	 * @details 元素引用为代理对象（如 std::vector<bool>::reference）时无法绑定到 T&，改为按值赋值
+	 * @param element 迭代器解引用的结果
+	 * @param json 元素的 JSON 值
+	 */
+	template <typename Reference>
+	static void assignElement(Reference &&element, const QJsonValue &json)
+	{
+		if constexpr (std::is_same<Reference, T &>::value)
+		{
+			JsonAssign<T>::assign(element, json);
+		}
+		else
+		{
+			element = Serializer<T>::fromJson(json);
+		}
+	}
+
+private:
+	static void resize(Container &target, int size)
+	{
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+		if constexpr (std::is_same<Container, QList<T>>::value)
+		{
+			// Qt 5 的 QList 没有 resize()
+			while (target.size() > size)
+			{
+				target.pop_back();
+			}
+			while (target.size() < size)
+			{
+				target.push_back(T());
+			}
+		}
+		else
+		{
+			target.resize(size);
+		}
+#else
+		target.resize(size);
+#endif
+	}
+};
+
+template <template <typename> class Container, typename T>
+struct JsonAssign<Container<T>, typename std::enable_if<std::is_same<Container<T>, QList<T>>::value || std::is_same<Container<T>, QVector<T>>::value>::type> : JsonAssignSequence<Container<T>>
+{
+};
+
+template <typename T>
+struct JsonAssign<std::vector<T>> : JsonAssignSequence<std::vector<T>>
+{
+};
+
+/**
+ * @brief 逐个元素追加
+ * @tparam T 值的类型
+ * @details
+ * 序列容器可以先 clear() 再逐个 append()，结果与 Serializer<T>::fromJson() 解码整个数组相同，
+ * 供增量解码在数组的元素陆续到达时写入，不必缓存整个数组；
+ * 也可以把数组分段各自 append() 到独立的容器中，再依次 splice() 到目标，供流水线解码并行解码各段
+ * supported 为 false 的类型整体解码
+ */
+template <typename T, typename Enable = void>
+struct JsonAppend
+{
+	static constexpr bool supported = false;
+};
+
+template <typename Container>
+struct JsonAppendSequence
+{
+	static constexpr bool supported = true;
+
+	static void clear(Container &target)
+	{
+		target.clear();
+	}
+
+	static void append(Container &target, const QJsonValue &json)
+	{
+		target.push_back(Serializer<typename Container::value_type>::fromJson(json));
+	}
+
+	/**
+	 * @brief 将 part 的元素移动到 target 末尾
+	 */
+	static void splice(Container &target, Container &part)
+	{
+		if (target.empty())
+		{
+			target = std::move(part);
+			return;
+		}
+		for (auto it = part.begin(); it != part.end(); ++it)
+		{
+			target.push_back(std::move(*it));
+		}
+		part.clear();
+	}
+};
+
+template <template <typename> class Container, typename T>
+struct JsonAppend<Container<T>, typename std::enable_if<std::is_same<Container<T>, QList<T>>::value || std::is_same<Container<T>, QVector<T>>::value>::type> : JsonAppendSequence<Container<T>>
+{
+};
+
+template <typename T>
+struct JsonAppend<std::vector<T>> : JsonAppendSequence<std::vector<T>>
+{
+};
+
+/**
+ * @brief 映射的覆盖：删除 JSON 中没有的键，已有的键原地覆盖，新的键插入
+ */
+template <typename Map, typename K, typename V>
+struct JsonAssignMap
+{
+	static void assign(Map &target, const QJsonValue &json)
+	{
+		const QJsonObject object = json.toObject();
+		for (auto it = target.begin(); it != target.end();)
+		{
+			if (object.contains(KeyCodec<K>::toKey(key(it))))
+			{
+				++it;
+			}
+			else
+			{
+				it = target.erase(it);
+			}
+		}
+		for (auto it = object.constBegin(); it != object.constEnd(); ++it)
+		{
+			K mapKey;
+			if (!KeyCodec<K>::fromKey(it.key(), mapKey))
+			{
+				continue;
+			}
+			auto existing = target.find(mapKey);
+			if (existing != target.end())
+			{
+				JsonAssign<V>::assign(mapped(existing), it.value());
+			}
+			else if constexpr (std::is_same<Map, std::map<K, V>>::value)
+			{
+				target.emplace(mapKey, Serializer<V>::fromJson(it.value()));
+			}
+			else
+			{
+				target.insert(mapKey, Serializer<V>::fromJson(it.value()));
+			}
+		}
+	}
+
+private:
+	template <typename Iterator>
+	static const K &key(const Iterator &it)
+	{
+		if constexpr (std::is_same<Map, std::map<K, V>>::value)
+		{
+			return it->first;
+		}
+		else
+		{
+			return it.key();
+		}
+	}
+
+	template <typename Iterator>
+	static V &mapped(Iterator &it)
+	{
+		if constexpr (std::is_same<Map, std::map<K, V>>::value)
+		{
+			return it->second;
+		}
+		else
+		{
+			return it.value();
+		}
+	}
+};
+
+template <template <typename, typename> class Map, typename K, typename V>
+struct JsonAssign<Map<K, V>, typename std::enable_if<std::is_same<Map<K, V>, QMap<K, V>>::value || std::is_same<Map<K, V>, QHash<K, V>>::value>::type> : JsonAssignMap<Map<K, V>, K, V>
+{
+};
+
+template <typename K, typename V>
+struct JsonAssign<std::map<K, V>> : JsonAssignMap<std::map<K, V>, K, V>
+{
+};
+
+/**
+ * @brief 合并补丁的原地应用
+ * @tparam T 成员类型
+ * @details
+ * null 将值重置为默认构造的值；可序列化类与映射按补丁对象递归合并；
+ * 序列容器的补丁是完整的新数组，元素个数不变时逐个元素以 JsonAssign 覆盖，沿用容器与元素原有的存储；其余情况整体替换
+ */
+template <typename T, typename Enable = void>
+struct JsonPatch
+{
+	static void apply(T &target, const QJsonValue &patch)
+	{
+		if (patch.isNull())
+		{
+			target = T();
+		}
+		else
+		{
+			target = Serializer<T>::fromJson(patch);
+		}
+	}
+};
+
+template <typename T>
+struct JsonPatch<T, typename std::enable_if<IsJsonSerializable<T>::value>::type>
+{
+	static void apply(T &target, const QJsonValue &patch)
+	{
+		if (patch.isObject())
+		{
+			target.applyJsonPatch(patch.toObject());
+		}
+		else
+		{
+			target = T();
+		}
+	}
+};
+
+/**
+ * @brief 序列容器的补丁：元素个数不变时原地逐个赋值
+ */
+template <typename Container>
+struct JsonPatchSequence
+{
+	using T = typename Container::value_type;
+
+	static void apply(Container &target, const QJsonValue &patch)
+	{
+		if (!patch.isArray())
+		{
+			target.clear();
+			return;
+		}
+		QJsonArray array = patch.toArray();
+		if (static_cast<int>(target.size()) != array.size())
+		{
+			target = Serializer<Container>::fromJson(array);
+			return;
+		}
+		int i = 0;
+		for (auto it = target.begin(); it != target.end(); ++it)
+		{
+			JsonAssignSequence<Container>::assignElement(*it, array.at(i++));
+		}
+	}
+};
+
+template <template <typename> class Container, typename T>
+struct JsonPatch<Container<T>, typename std::enable_if<std::is_same<Container<T>, QList<T>>::value || std::is_same<Container<T>, QVector<T>>::value>::type> : JsonPatchSequence<Container<T>>
+{
+};
+
+template <typename T>
+struct JsonPatch<std::vector<T>> : JsonPatchSequence<std::vector<T>>
+{
+};
+
+/**
+ * @brief 映射的补丁：null 删除键，已有的键递归合并，新的键插入
+ */
+template <typename Map, typename K, typename V>
+struct JsonPatchMap
+{
+	static void apply(Map &target, const QJsonValue &patch)
+	{
+		if (!patch.isObject())
+		{
+			target.clear();
+			return;
+		}
+		const QJsonObject object = patch.toObject();
+		for (auto it = object.constBegin(); it != object.constEnd(); ++it)
+		{
+			K key;
+			if (!KeyCodec<K>::fromKey(it.key(), key))
+			{
+				continue;
+			}
+			auto existing = target.find(key);
+			if (it.value().isNull())
+			{
+				if (existing != target.end())
+				{
+					target.erase(existing);
+				}
+			}
+			else if (existing != target.end())
+			{
+				JsonPatch<V>::apply(mapped(existing), it.value());
+			}
+			else
+			{
+				insert(target, key, Serializer<V>::fromJson(it.value()));
+			}
+		}
+	}
+
+private:
+	template <typename Iterator>
+	static V &mapped(Iterator &it)
+	{
+		if constexpr (std::is_same<Map, std::map<K, V>>::value)
+		{
+			return it->second;
+		}
+		else
+		{
+			return it.value();
+		}
+	}
+
+	static void insert(Map &target, const K &key, V &&value)
+	{
+		if constexpr (std::is_same<Map, std::map<K, V>>::value)
+		{
+			target.emplace(key, std::move(value));
+		}
+		else
+		{
+			target.insert(key, std::move(value));
+		}
+	}
+};
+
+template <template <typename, typename> class Map, typename K, typename V>
+struct JsonPatch<Map<K, V>, typename std::enable_if<std::is_same<Map<K, V>, QMap<K, V>>::value || std::is_same<Map<K, V>, QHash<K, V>>::value>::type> : JsonPatchMap<Map<K, V>, K, V>
+{
+};
+
+template <typename K, typename V>
+struct JsonPatch<std::map<K, V>> : JsonPatchMap<std::map<K, V>, K, V>
+{
+};
+
+/**
+ * @brief JSON 合并补丁（RFC 7386）
+ * @details
+ * diff() 按类的属性表直接比较两个对象的成员，不需要分别序列化后再比较 JSON 树
+ * @code
+ * QJsonObject patch = JsonMergePatch::diff(previous, current);
+ * if (!patch.isEmpty())
+ * {
+ *     publish(QJsonDocument(patch).toJson(QJsonDocument::Compact));
+ * }
+ * @endcode
+ * apply() 把补丁原地应用到对象，只修改补丁中出现的成员，并尽量沿用成员原有的存储
+ */
+struct JsonMergePatch
+{
+	/**
+	 * @brief 生成从 before 到 after 的合并补丁
+	 * @tparam T 可序列化类
+	 * @param before 修改前的对象
+	 * @param after 修改后的对象
+	 * @return QJsonObject 只包含有变化属性的合并补丁，没有变化时为空对象
+	 */
+	template <typename T>
+	static QJsonObject diff(const T &before, const T &after)
+	{
+		static_assert(IsJsonSerializable<T>::value, "merge patch requires a serializable class");
+		return before.diffJson(after);
+	}
+
+	/**
+	 * @brief 原地应用合并补丁
+	 * @tparam T 可序列化类
+	 * @param target 目标对象
+	 * @param patch 合并补丁
+	 */
+	template <typename T>
+	static void apply(T &target, const QJsonObject &patch)
+	{
+		static_assert(IsJsonSerializable<T>::value, "merge patch requires a serializable class");
+		target.applyJsonPatch(patch);
+	}
+};
+
+/**
+ * @brief 判断类型是否经由共享指针持有对象
+ * @tparam T 待判断的类型
+ * @details 共享指针本身以及元素（或映射的键、值）经由共享指针持有对象的容器；
+ * 被指向的对象可以不经属性的 setter 原地修改
+ */
+template <typename T, typename Enable = void>
+struct JsonHoldsShared : std::false_type
+{
+};
+
+template <typename T>
+struct JsonHoldsShared<std::shared_ptr<T>> : std::true_type
+{
+};
+
+template <typename T>
+struct JsonHoldsShared<QSharedPointer<T>> : std::true_type
+{
+};
+
+template <typename K, typename V>
+struct JsonHoldsShared<std::pair<K, V>> : std::integral_constant<bool, JsonHoldsShared<K>::value || JsonHoldsShared<V>::value>
+{
+};
+
+template <typename T>
+struct JsonHoldsShared<T, typename std::enable_if<!std::is_same<T, QSharedPointer<typename T::value_type>>::value>::type> : JsonHoldsShared<typename T::value_type>
+{
+};
+
+/**
+ * @brief JSON 属性的成员访问实现
+ * @tparam Class 属性所属的类
+ * @tparam Type 属性的数据类型
+ * @tparam Codec 属性使用的序列化器
+ * @details 使用默认序列化器的属性直接写入成员，自定义序列化器的属性经由其 toJson() 写入
+ */
+template <typename Class, typename Type, typename Codec>
+class JsonFieldAccessImpl final : public JsonFieldAccess
+{
+public:
+	explicit JsonFieldAccessImpl(Type Class::*member)
+		: m_member(member)
+	{
+	}
+
+	void write(JsonWriter &writer, const void *gadget) const override
+	{
+		const Type &value = static_cast<const Class *>(gadget)->*m_member;
+		if constexpr (std::is_same<Codec, Serializer<Type>>::value)
+		{
+			JsonWrite<Type>::write(writer, value);
+		}
+		else
+		{
+			writer.writeValue(Codec::toJson(value));
+		}
+	}
+
+	bool diff(const void *before, const void *after, QJsonValue &patch) const override
+	{
+		const Type &previous = static_cast<const Class *>(before)->*m_member;
+		const Type &current = static_cast<const Class *>(after)->*m_member;
+		if constexpr (std::is_same<Codec, Serializer<Type>>::value)
+		{
+			return JsonDiff<Type>::diff(previous, current, patch);
+		}
+		else
+		{
+			QJsonValue value = Codec::toJson(current);
+			if (Codec::toJson(previous) == value)
+			{
+				return false;
+			}
+			patch = value;
+			return true;
+		}
+	}
+
+	void patch(void *gadget, const QJsonValue &patch) const override
+	{
+		Class *object = static_cast<Class *>(gadget);
+		if constexpr (std::is_same<Codec, Serializer<Type>>::value)
+		{
+			JsonPatch<Type>::apply(object->*m_member, patch);
+		}
+		else
+		{
+			object->*m_member = patch.isNull() ? Type() : Codec::fromJson(patch);
+		}
+		JsonDirtyTracking<Class>::mark(object);
+	}
+
+	void assign(void *gadget, const QJsonValue &json) const override
+	{
+		Class *object = static_cast<Class *>(gadget);
+		if constexpr (std::is_same<Codec, Serializer<Type>>::value)
+		{
+			JsonAssign<Type>::assign(object->*m_member, json);
+		}
+		else
+		{
+			object->*m_member = Codec::fromJson(json);
+		}
+		JsonDirtyTracking<Class>::mark(object);
+	}
+
+	void reset(void *gadget) const override
+	{
+		Class *object = static_cast<Class *>(gadget);
+		if constexpr (std::is_abstract<Class>::value || !std::is_default_constructible<Class>::value)
+		{
+			object->*m_member = Type();
+		}
+		else
+		{
+			static const Class defaults{};
+			object->*m_member = defaults.*m_member;
+		}
+		JsonDirtyTracking<Class>::mark(object);
+	}
+
+	bool clearSequence(void *gadget) const override
+	{
+		if constexpr (std::is_same<Codec, Serializer<Type>>::value && JsonAppend<Type>::supported)
+		{
+			Class *object = static_cast<Class *>(gadget);
+			JsonAppend<Type>::clear(object->*m_member);
+			JsonDirtyTracking<Class>::mark(object);
+			return true;
+		}
+		else
+		{
+			Q_UNUSED(gadget);
+			return false;
+		}
+	}
+
+	void appendElement(void *gadget, const QJsonValue &element) const override
+	{
+		if constexpr (std::is_same<Codec, Serializer<Type>>::value && JsonAppend<Type>::supported)
+		{
+			Class *object = static_cast<Class *>(gadget);
+			JsonAppend<Type>::append(object->*m_member, element);
+			JsonDirtyTracking<Class>::mark(object);
+		}
+		else
+		{
+			Q_UNUSED(gadget);
+			Q_UNUSED(element);
+		}
+	}
+
+	std::shared_ptr<void> decodeElements(const QJsonArray &elements) const override
+	{
+		if constexpr (std::is_same<Codec, Serializer<Type>>::value && JsonAppend<Type>::supported)
+		{
+			std::shared_ptr<Type> part = std::make_shared<Type>();
+			for (const QJsonValue &element : elements)
+			{
+				JsonAppend<Type>::append(*part, element);
+			}
+			return part;
+		}
+		else
+		{
+			Q_UNUSED(elements);
+			return nullptr;
+		}
+	}
+
+	void spliceElements(void *gadget, const std::vector<std::shared_ptr<void>> &parts) const override
+	{
+		if constexpr (std::is_same<Codec, Serializer<Type>>::value && JsonAppend<Type>::supported)
+		{
+			Class *object = static_cast<Class *>(gadget);
+			Type &target = object->*m_member;
+			JsonAppend<Type>::clear(target);
+			for (const std::shared_ptr<void> &part : parts)
+			{
+				JsonAppend<Type>::splice(target, *static_cast<Type *>(part.get()));
+			}
+			JsonDirtyTracking<Class>::mark(object);
+		}
+		else
+		{
+			Q_UNUSED(gadget);
+			Q_UNUSED(parts);
+		}
+	}
+
+	bool holdsShared() const override
+	{
+		return JsonHoldsShared<Type>::value;
+	}
+
+	std::unique_ptr<JsonEncodeFrame> encodeFrame(const void *gadget) const override
+	{
+		if constexpr (std::is_same<Codec, Serializer<Type>>::value)
+		{
+			return JsonEncodeFrameOf<Type>::create(static_cast<const Class *>(gadget)->*m_member);
+		}
+		else
+		{
+			Q_UNUSED(gadget);
+			return nullptr;
+		}
+	}
+
+private:
+	Type Class::*m_member;
+};
+
+/**
+ * @brief 列式编码的序列化器
+ * @tparam Container 元素为可序列化类的序列容器（std::vector、QList 或 QVector）
+ * @details
+ * 同构对象数组的每个元素都重复相同的键，列式编码只输出一次列名：
+ * {"$cols":["name","age","hobbies"],"$rows":[["A",18,["running","TV"]],...]}
+ * 列名来自元素类型的 JsonPropertyTable，解码时每个数组只解析一次列名与属性的对应关系
+ * 解码同样接受普通数组，便于与未启用列式编码的一端互通
+ */
+template <typename Container>
+struct JsonColumnarSerializer
+{
+	using T = typename Container::value_type;
+	static_assert(IsJsonSerializable<T>::value, "columnar encoding requires serializable elements");
+
+	/**
+	 * @brief 将容器转换为列式 JSON 对象
+	 * @param container 待序列化的容器
+	 * @return QJsonValue 包含 "$cols" 与 "$rows" 的 JSON 对象
+	 */
+	static QJsonValue toJson(const Container &container)
+	{
+		const JsonPropertyTable &table = JsonPropertyTable::of<T>();
+		const auto &entries = table.entries();
+		QJsonArray cols;
+		for (int i = 0; i < entries.size(); i++)
+		{
+			cols.append(table.key(i));
+		}
+
+		QJsonArray rows;
+		for (const auto &item : container)
+		{
+			QJsonArray row;
+			for (const auto &entry : entries)
+			{
+				row.append(entry.property.readOnGadget(&item).toJsonValue());
+			}
+			rows.append(row);
+		}
+
+		QJsonObject json;
+		json.insert(QStringLiteral("$cols"), cols);
+		json.insert(QStringLiteral("$rows"), rows);
+		return json;
+	}
+
+	/**
+	 * @brief 从列式 JSON 对象（或普通数组）还原容器
+	 * @param json JSON 值
+	 * @return Container 还原后的容器
+	 */
+	static Container fromJson(const QJsonValue &json)
+	{
+		if (!json.isObject())
+		{
+			return Serializer<Container>::fromJson(json);
+		}
+
+		QJsonObject obj = json.toObject();
+		QJsonArray cols = obj.value(QStringLiteral("$cols")).toArray();
+		QJsonArray rows = obj.value(QStringLiteral("$rows")).toArray();
+
+		// 每个数组只解析一次列名，与 JsonSerializable::fromJson 一样接受完整键名与短键名
+		const JsonPropertyTable &table = JsonPropertyTable::of<T>();
+		QVector<QMetaProperty> columns;
+		columns.reserve(cols.size());
+		for (const auto &col : cols)
+		{
+			int index = table.indexOf(col.toString());
+			columns.append(index >= 0 ? table.entries().at(index).property : QMetaProperty());
+		}
+
+		Container result;
+		result.reserve(rows.size());
+		for (const auto &rowValue : rows)
+		{
+			QJsonArray row = rowValue.toArray();
+			T item;
+			int count = qMin(row.size(), columns.size());
+			for (int c = 0; c < count; c++)
+			{
+				if (columns.at(c).isValid())
+				{
+					columns.at(c).writeOnGadget(&item, row.at(c));
+				}
+			}
+			result.push_back(item);
+		}
+		return result;
+	}
+};
+
+/**
+ * @brief 差分编码的序列化器
+ * @tparam Container 整数序列容器（std::vector、QList 或 QVector）
+ * @tparam ZigZag 是否对差值做 zig-zag 变换（使负差值也编码为非负整数）
+ * @details
+ * 单调的时间戳、序号数组的相邻元素差值很小，差分编码只写首个值和后续的差值：
+ * [1700000000000,1700000000250,1700000000500] 写为 {"$delta":[1700000000000,250,250]}
+ * 启用 zig-zag 时写为 {"$zigzag":[...]}，每个值按 (n << 1) ^ (n >> 63) 变换
+ * 解码同样接受普通数组
+ */
+template <typename Container, bool ZigZag = false>
+struct JsonDeltaSerializer
+{
+	using T = typename Container::value_type;
+	static_assert(std::is_integral<T>::value, "delta encoding requires integral elements");
+
+	/**
+	 * @brief 将容器转换为差分编码的 JSON 对象
+	 * @param container 待序列化的容器
+	 * @return QJsonValue 包含 "$delta" 或 "$zigzag" 数组的 JSON 对象
+	 */
+	static QJsonValue toJson(const Container &container)
+	{
+		QJsonArray deltas;
+		quint64 previous = 0;
+		for (const auto &item : container)
+		{
+			// 以无符号算术求差，溢出时按补码回绕，解码时同样回绕还原
+			quint64 current = static_cast<quint64>(static_cast<qint64>(item));
+			qint64 delta = static_cast<qint64>(current - previous);
+			previous = current;
+			deltas.append(JsonNumber<qint64>::toJson(ZigZag ? static_cast<qint64>(encodeZigZag(delta)) : delta));
+		}
+		QJsonObject json;
+		json.insert(key(), deltas);
+		return json;
+	}
+
+	/**
+	 * @brief 从差分编码的 JSON 对象（或普通数组）还原容器
+	 * @param json JSON 值
+	 * @return Container 还原后的容器
+	 */
+	static Container fromJson(const QJsonValue &json)
+	{
+		if (!json.isObject())
+		{
+			return Serializer<Container>::fromJson(json);
+		}
+
+		QJsonObject obj = json.toObject();
+		bool zigZag = obj.contains(QStringLiteral("$zigzag"));
+		QJsonArray deltas = obj.value(zigZag ? QStringLiteral("$zigzag") : QStringLiteral("$delta")).toArray();
+
+		Container result;
+		result.reserve(deltas.size());
+		quint64 current = 0;
+		for (const auto &item : deltas)
+		{
+			qint64 delta = JsonNumber<qint64>::fromJson(item);
+			current += static_cast<quint64>(zigZag ? decodeZigZag(static_cast<quint64>(delta)) : delta);
+			result.push_back(static_cast<T>(static_cast<qint64>(current)));
+		}
+		return result;
+	}
+
+private:
+	static QString key()
+	{
+		return ZigZag ? QStringLiteral("$zigzag") : QStringLiteral("$delta");
+	}
+
+	static quint64 encodeZigZag(qint64 value)
+	{
+		return (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63);
+	}
+
+	static qint64 decodeZigZag(quint64 value)
+	{
+		return static_cast<qint64>((value >> 1) ^ (0 - (value & 1)));
+	}
+};
+
+/**
+ * @brief 常用序列化器的显式实例化
+ * @details
+ * 定义 JSON_SERIALIZER_EXTERN_TEMPLATES 时（链接 JsonSerializer 库目标会自动定义），
+ * 下列实例化在各翻译单元中只做 extern 声明，由 JsonSerializer.cpp 统一实例化一次，
+ * 避免每个包含 DTO 头文件的翻译单元重复实例化同样的容器序列化器
+ * extern template 不约束内联函数，因此这些模板的成员函数均在类外定义；在类内定义的成员仍会在各单元中实例化
+ * 未定义时保持纯头文件用法，行为不变
+ */
+#if defined(JSON_SERIALIZER_INSTANTIATE)
+#define JSON_SERIALIZER_EXTERN_TEMPLATE template
+#elif defined(JSON_SERIALIZER_EXTERN_TEMPLATES)
+#define JSON_SERIALIZER_EXTERN_TEMPLATE extern template
+#endif
+
+#ifdef JSON_SERIALIZER_EXTERN_TEMPLATE
+JSON_SERIALIZER_EXTERN_TEMPLATE struct JsonNumber<bool>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct JsonNumber<int>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct JsonNumber<qint64>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct JsonNumber<double>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<bool>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<int>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<qint64>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<double>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<QString>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<QList<int>>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<QList<double>>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<QList<QString>>;
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+// Qt 6 中 QVector 是 QList 的别名，不能重复实例化
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<QVector<int>>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<QVector<double>>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<QVector<QString>>;
+#endif
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<std::vector<int>>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<std::vector<double>>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<std::vector<QString>>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct KeyCodec<int>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<QMap<QString, int>>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<QMap<QString, QString>>;
+JSON_SERIALIZER_EXTERN_TEMPLATE struct Serializer<QHash<QString, QString>>;
+#undef JSON_SERIALIZER_EXTERN_TEMPLATE
+#endif
+
+/**
+ * @brief 使用指定序列化器的 JSON 属性声明宏
+ * @details
+ * 与 JSON_PROPERTY 相同，但属性值通过给定的序列化器（提供 toJson/fromJson 静态函数）转换
+ * 每个属性在静态初始化阶段把成员访问接口登记到 JsonFieldRegistry（见 JsonFieldBinding）
+ * @param type 属性的数据类型
+ * @param name 属性名称
+ * @param ... 序列化器类型，允许包含逗号
+ */
+#define JSON_PROPERTY_WITH(type, name, ...)                                                   \
+	Q_PROPERTY(QJsonValue name READ get_json_##name WRITE set_json_##name)                    \
+                                                                                              \
+private:                                                                                      \
+	type m_##name;                                                                            \
+	QJsonValue get_json_##name() const { return __VA_ARGS__::toJson(m_##name); }              \
+	void set_json_##name(const QJsonValue &value)                                             \
+	{                                                                                         \
+		m_##name = __VA_ARGS__::fromJson(value);                                              \
+		JsonDirtyTracking<std::remove_pointer_t<decltype(this)>>::mark(this);                 \
+	}                                                                                         \
+	struct json_field_##name                                                                  \
+	{                                                                                         \
+		static const char *key() { return #name; }                                            \
+		template <typename Self>                                                              \
+		static const JsonFieldAccess *access()                                                \
+		{                                                                                     \
+			static const JsonFieldAccessImpl<Self, type, __VA_ARGS__> field(&Self::m_##name); \
+			return &field;                                                                    \
+		}                                                                                     \
+	};                                                                                        \
+	void json_register_##name() const                                                         \
+	{                                                                                         \
+		using Self = std::remove_cv_t<std::remove_pointer_t<decltype(this)>>;                 \
+		static_cast<void>(JsonFieldBinding<Self, json_field_##name>::registered);             \
+	}                                                                                         \
+                                                                                              \
+public:                                                                                       \
+	type name() const { return m_##name; }                                                    \
+	const type &ref_##name() const { return m_##name; }                                       \
+	void set_##name(const type &value)                                                        \
+	{                                                                                         \
+		m_##name = value;                                                                     \
+		JsonDirtyTracking<std::remove_pointer_t<decltype(this)>>::mark(this);                 \
+	}                                                                                         \
+	void set_##name(type &&value)                                                             \
+	{                                                                                         \
+		m_##name = std::move(value);                                                          \
+		JsonDirtyTracking<std::remove_pointer_t<decltype(this)>>::mark(this);                 \
+	}
+
+/**
+ * @brief JSON 属性声明宏、使用Serializer<T>进行展开
+ * @details 简化 JSON 属性的声明、获取和设置
+ * @param type 属性的数据类型
+ * @param name 属性名称
+ */
+#define JSON_PROPERTY(type, name) JSON_PROPERTY_WITH(type, name, Serializer<type>)
+
+/**
+ * @brief 固定小数位数输出的 JSON 属性声明宏
+ * @param type 属性的数据类型（浮点数或其容器）
+ * @param name 属性名称
+ * @param decimals 小数位数
+ */
+#define JSON_PROPERTY_DECIMALS(type, name, decimals) \
+	JSON_PROPERTY_WITH(type, name, JsonPrecisionSerializer<type, JsonFloatPrecision::Decimals, decimals>)
+
+/**
+ * @brief 固定有效数字位数输出的 JSON 属性声明宏
+ * @param type 属性的数据类型（浮点数或其容器）
+ * @param name 属性名称
+ * @param digits 有效数字位数
+ */
+#define JSON_PROPERTY_SIGNIFICANT(type, name, digits) \
+	JSON_PROPERTY_WITH(type, name, JsonPrecisionSerializer<type, JsonFloatPrecision::SignificantDigits, digits>)
+
+/**
+ * @brief 列式编码的 JSON 属性声明宏
+ * @param type 属性的数据类型（元素为可序列化类的序列容器）
+ * @param name 属性名称
+ */
+#define JSON_PROPERTY_COLUMNAR(type, name) \
+	JSON_PROPERTY_WITH(type, name, JsonColumnarSerializer<type>)
+
+/**
+ * @brief 带短键名的 JSON 属性声明宏
+ * @details 短键名通过 Q_CLASSINFO 记录在元对象中，在 JsonCompactKeysScope 中输出
+ * @param type 属性的数据类型
+ * @param name 属性名称
+ * @param alias 短键名
+ */
+#define JSON_PROPERTY_ALIAS(type, name, alias) \
+	Q_CLASSINFO("json.alias:" #name, #alias)   \
+	JSON_PROPERTY(type, name)
+
+/**
+ * @brief 差分编码的 JSON 属性声明宏
+ * @details 需要 zig-zag 变换时使用 JSON_PROPERTY_WITH(type, name, JsonDeltaSerializer<type, true>)
+ * @param type 属性的数据类型（整数序列容器）
  * @param name 属性名称
  */
-#define JSON_PROPERTY(type, name)                                                                   \
-	Q_PROPERTY(QJsonValue name READ get_json_##name WRITE set_json_##name)                          \
-private:                                                                                            \
-	type m_##name;                                                                                  \
-	QJsonValue get_json_##name() const { return Serializer<type>::toJson(m_##name); }               \
-	void set_json_##name(const QJsonValue &value) { m_##name = Serializer<type>::fromJson(value); } \
-                                                                                                    \
-public:                                                                                             \
-	type name() const { return m_##name; }                                                          \
-	void set_##name(const type &value) { m_##name = value; }
+#define JSON_PROPERTY_DELTA(type, name) \
+	JSON_PROPERTY_WITH(type, name, JsonDeltaSerializer<type>)
 
 #endif // JSON_SERIALIZER_H
\ No newline at end of file
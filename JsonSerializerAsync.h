@@ -0,0 +1,154 @@
+// File: JsonSerializerAsync
+// Author: linxmouse@gmail.com
+// Creation: 2024/09/29
+#ifndef JSON_SERIALIZER_ASYNC_H
+#define JSON_SERIALIZER_ASYNC_H
+
+#include "JsonSerializer.h"
+
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QObject>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
+
+/**
+ * @brief 异步序列化接口
+ * @details
+ * 在线程池中完成编码或解码，避免大数据量的序列化阻塞事件循环线程
+ * 输入按值传入：调用方可以 std::move 转移所有权，否则得到一份快照（Qt 容器与字符串为隐式共享，复制开销很小），
+ * 任务执行期间调用方继续修改原对象不会影响结果
+ * 调用线程当前的浮点精度策略与短键名设置会带入任务中；JsonReferenceScope 不跨线程，
+ * 任务内如需共享引用请在数据中自行建立作用域
+ * 多态对象按静态类型 T 复制，请以实际类型调用
+ * 需要链接 Qt Concurrent 模块
+ * @code
+ * QFuture<QByteArray> future = JsonAsync::toRawJsonAsync(pagedPerson);
+ * JsonAsync::then(future, this, [this](const QByteArray &json) { socket->write(json); });
+ * @endcode
+ */
+struct JsonAsync
+{
+	/**
+	 * @brief 设置异步序列化默认使用的线程池
+	 * @param pool 线程池，传入 nullptr 恢复为 QThreadPool::globalInstance()
+	 */
+	static void setThreadPool(QThreadPool *pool)
+	{
+		defaultPool().store(pool);
+	}
+
+	/**
+	 * @brief 返回异步序列化默认使用的线程池
+	 */
+	static QThreadPool *threadPool()
+	{
+		QThreadPool *pool = defaultPool().load();
+		return pool ? pool : QThreadPool::globalInstance();
+	}
+
+	/**
+	 * @brief 在线程池中将值编码为 JSON 字节数据
+	 * @tparam T 可序列化的值类型
+	 * @param value 待编码的值（移动或复制为快照）
+	 * @param pool 执行任务的线程池，为空时使用 threadPool()
+	 * @return QFuture<QByteArray> 与 toRawJson() 格式相同的 JSON 字节数据
+	 */
+	template <typename T>
+	static QFuture<QByteArray> toRawJsonAsync(T value, QThreadPool *pool = nullptr)
+	{
+		const JsonFloatPrecision precision = JsonFloatPrecision::current();
+		const bool compact = JsonCompactKeysScope::active();
+		return QtConcurrent::run(pool ? pool : threadPool(), [value = std::move(value), precision, compact]() -> QByteArray {
+			JsonFloatPrecisionScope precisionScope(precision);
+			JsonCompactKeysScope keysScope(compact);
+			return encode(value);
+		});
+	}
+
+	/**
+	 * @brief 在线程池中从 JSON 字节数据解码
+	 * @tparam T 目标类型
+	 * @param data JSON 字节数据（移动或共享）
+	 * @param pool 执行任务的线程池，为空时使用 threadPool()
+	 * @return QFuture<T> 解码结果
+	 */
+	template <typename T>
+	static QFuture<T> fromJsonAsync(QByteArray data, QThreadPool *pool = nullptr)
+	{
+		const bool compact = JsonCompactKeysScope::active();
+		return QtConcurrent::run(pool ? pool : threadPool(), [data = std::move(data), compact]() -> T {
+			JsonCompactKeysScope keysScope(compact);
+			QJsonDocument document = QJsonDocument::fromJson(data);
+			return Serializer<T>::fromJson(document.isArray() ? QJsonValue(document.array()) : QJsonValue(document.object()));
+		});
+	}
+
+	/**
+	 * @brief 任务完成后在 context 所在线程中调用 function
+	 * @details
+	 * Qt 5 的 QFuture 没有 then()，此处以 QFutureWatcher 实现，Qt 5 与 Qt 6 用法相同
+	 * 需在 context 所在线程中调用；watcher 以 context 为父对象，context 先于任务完成被销毁时不会调用 function
+	 * 任务被取消、抛出异常或没有结果时不调用 function，需要得知时使用带 canceled 参数的重载
+	 * @param future 异步任务
+	 * @param context 接收结果的对象，决定回调所在的线程
+	 * @param function 以任务结果为参数的回调
+	 */
+	template <typename T, typename Function>
+	static void then(const QFuture<T> &future, QObject *context, Function function)
+	{
+		then(future, context, std::move(function), []() {});
+	}
+
+	/**
+	 * @brief 任务完成后在 context 所在线程中调用 function，任务没有结果时调用 canceled
+	 * @details
+	 * 任务抛出的异常使 QFuture 进入取消状态，同样调用 canceled；
+	 * 需要异常对象时可在 canceled 中对 future 调用 waitForFinished()，QFuture 会重新抛出该异常
+	 * @param future 异步任务
+	 * @param context 接收结果的对象，决定回调所在的线程
+	 * @param function 以任务结果为参数的回调
+	 * @param canceled 任务被取消、抛出异常或没有结果时的回调，不带参数
+	 */
+	template <typename T, typename Function, typename Canceled>
+	static void then(const QFuture<T> &future, QObject *context, Function function, Canceled canceled)
+	{
+		auto *watcher = new QFutureWatcher<T>(context);
+		QObject::connect(watcher, &QFutureWatcher<T>::finished, context, [watcher, function, canceled]() {
+			// 取消或异常时 result() 会抛出异常或返回无效值，不能调用
+			if (watcher->isCanceled() || watcher->future().resultCount() == 0)
+			{
+				canceled();
+			}
+			else
+			{
+				function(watcher->result());
+			}
+			watcher->deleteLater();
+		});
+		watcher->setFuture(future);
+	}
+
+private:
+	static std::atomic<QThreadPool *> &defaultPool()
+	{
+		static std::atomic<QThreadPool *> pool{nullptr};
+		return pool;
+	}
+
+	template <typename T>
+	static QByteArray encode(const T &value)
+	{
+		if constexpr (IsJsonSerializable<T>::value)
+		{
+			return value.toRawJson();
+		}
+		else
+		{
+			QJsonValue json = Serializer<T>::toJson(value);
+			return json.isArray() ? QJsonDocument(json.toArray()).toJson() : QJsonDocument(json.toObject()).toJson();
+		}
+	}
+};
+
+#endif // JSON_SERIALIZER_ASYNC_H
@@ -0,0 +1,187 @@
+// File: JsonSerializerDecodeCache
+// Author: linxmouse@gmail.com
+// Creation: 2024/09/29
+#ifndef JSON_SERIALIZER_DECODE_CACHE_H
+#define JSON_SERIALIZER_DECODE_CACHE_H
+
+#include "JsonSerializerFingerprint.h"
+
+#include <list>
+
+/**
+ * @brief 按内容寻址的解码缓存
+ * @tparam T 解码的目标类型
+ * @details
+ * 以输入字节的 JsonHash64 哈希为键缓存解码结果，重复出现的相同输入直接返回共享的不可变对象，跳过解析与解码
+ * 命中时还会逐字节比较输入，哈希碰撞不会返回错误的对象
+ * 是否处于 JsonCompactKeysScope 会影响自动短键名的解析，两种情况分别缓存
+ * 按最近最少使用淘汰，同时限制条目数与内存：每个条目按输入大小的两倍计算
+ * （保存的输入副本与解码对象的估计大小），超过 maxBytes 的单个输入不缓存
+ * 所有方法都可以在多个线程中同时调用；解码在锁外进行，不同输入的解码互不阻塞
+ * @code
+ * static JsonDecodeCache<ConfigPush> cache(128, 32 * 1024 * 1024);
+ * std::shared_ptr<const ConfigPush> config = cache.fromJson(payload);
+ * @endcode
+ */
+template <typename T>
+class JsonDecodeCache
+{
+public:
+	/**
+	 * @param maxEntries 最多缓存的条目数
+	 * @param maxBytes 缓存占用的内存上限（字节，按条目估计值累计）
+	 */
+	explicit JsonDecodeCache(int maxEntries = 256, qint64 maxBytes = 64 * 1024 * 1024)
+		: m_maxEntries(maxEntries), m_maxBytes(maxBytes)
+	{
+	}
+
+	JsonDecodeCache(const JsonDecodeCache &) = delete;
+	JsonDecodeCache &operator=(const JsonDecodeCache &) = delete;
+
+	/**
+	 * @brief 解码 JSON 字节数据，相同的输入返回同一个对象
+	 * @param data JSON 字节数据
+	 * @return std::shared_ptr<const T> 解码结果；输入不是合法的 JSON 时返回空且不缓存
+	 */
+	std::shared_ptr<const T> fromJson(const QByteArray &data)
+	{
+		const bool compact = JsonCompactKeysScope::active();
+		const quint64 key = JsonHash64::hash(data, compact ? 1 : 0);
+		{
+			QMutexLocker locker(&m_mutex);
+			auto found = m_index.constFind(key);
+			if (found != m_index.constEnd() && found.value()->compact == compact && found.value()->data == data)
+			{
+				m_entries.splice(m_entries.begin(), m_entries, found.value());
+				m_hits++;
+				return found.value()->value;
+			}
+			m_misses++;
+		}
+
+		std::shared_ptr<const T> value = decode(data);
+		if (!value)
+		{
+			return value;
+		}
+		const qint64 cost = static_cast<qint64>(data.size()) * 2;
+		QMutexLocker locker(&m_mutex);
+		if (cost > m_maxBytes)
+		{
+			return value;
+		}
+		auto found = m_index.find(key);
+		if (found != m_index.end())
+		{
+			if (found.value()->compact == compact && found.value()->data == data)
+			{
+				// 其他线程已缓存了同一输入
+				m_entries.splice(m_entries.begin(), m_entries, found.value());
+				return found.value()->value;
+			}
+			// 哈希碰撞：新输入替换旧条目
+			m_bytes -= found.value()->cost;
+			m_entries.erase(found.value());
+			m_index.erase(found);
+		}
+		m_entries.push_front(Entry{key, compact, data, value, cost});
+		m_index.insert(key, m_entries.begin());
+		m_bytes += cost;
+		evict();
+		return value;
+	}
+
+	/**
+	 * @brief 清空缓存；已返回的对象不受影响
+	 */
+	void clear()
+	{
+		QMutexLocker locker(&m_mutex);
+		m_entries.clear();
+		m_index.clear();
+		m_bytes = 0;
+	}
+
+	/**
+	 * @brief 修改条目数与内存上限，超出的条目立即淘汰
+	 */
+	void setLimits(int maxEntries, qint64 maxBytes)
+	{
+		QMutexLocker locker(&m_mutex);
+		m_maxEntries = maxEntries;
+		m_maxBytes = maxBytes;
+		evict();
+	}
+
+	int size() const
+	{
+		QMutexLocker locker(&m_mutex);
+		return m_index.size();
+	}
+
+	/**
+	 * @brief 当前占用的内存估计值（字节）
+	 */
+	qint64 bytes() const
+	{
+		QMutexLocker locker(&m_mutex);
+		return m_bytes;
+	}
+
+	quint64 hits() const
+	{
+		QMutexLocker locker(&m_mutex);
+		return m_hits;
+	}
+
+	quint64 misses() const
+	{
+		QMutexLocker locker(&m_mutex);
+		return m_misses;
+	}
+
+private:
+	struct Entry
+	{
+		quint64 key;
+		bool compact;
+		QByteArray data;
+		std::shared_ptr<const T> value;
+		qint64 cost;
+	};
+
+	static std::shared_ptr<const T> decode(const QByteArray &data)
+	{
+		QJsonParseError error;
+		QJsonDocument document = QJsonDocument::fromJson(data, &error);
+		if (error.error != QJsonParseError::NoError)
+		{
+			return nullptr;
+		}
+		const QJsonValue json = document.isArray() ? QJsonValue(document.array()) : QJsonValue(document.object());
+		return std::make_shared<const T>(Serializer<T>::fromJson(json));
+	}
+
+	void evict()
+	{
+		while (!m_entries.empty() && (static_cast<int>(m_entries.size()) > m_maxEntries || m_bytes > m_maxBytes))
+		{
+			const Entry &last = m_entries.back();
+			m_bytes -= last.cost;
+			m_index.remove(last.key);
+			m_entries.pop_back();
+		}
+	}
+
+	mutable QMutex m_mutex;
+	std::list<Entry> m_entries;
+	QHash<quint64, typename std::list<Entry>::iterator> m_index;
+	int m_maxEntries;
+	qint64 m_maxBytes;
+	qint64 m_bytes = 0;
+	quint64 m_hits = 0;
+	quint64 m_misses = 0;
+};
+
+#endif // JSON_SERIALIZER_DECODE_CACHE_H
@@ -0,0 +1,213 @@
+// File: JsonSerializerFingerprint
+// Author: linxmouse@gmail.com
+// Creation: 2024/09/29
+#ifndef JSON_SERIALIZER_FINGERPRINT_H
+#define JSON_SERIALIZER_FINGERPRINT_H
+
+#include "JsonSerializer.h"
+
+#include <QtEndian>
+#include <cstring>
+
+/**
+ * @brief 流式 64 位哈希（XXH64 算法）
+ * @details 结果只取决于输入字节与种子，与进程、平台字节序无关，可以跨进程比较与持久化
+ */
+class JsonHash64
+{
+public:
+	explicit JsonHash64(quint64 seed = 0)
+		: m_seed(seed)
+	{
+		m_v[0] = seed + Prime1 + Prime2;
+		m_v[1] = seed + Prime2;
+		m_v[2] = seed;
+		m_v[3] = seed - Prime1;
+	}
+
+	/**
+	 * @brief 追加输入
+	 * @param data 字节数据，size 为 0 时可以为 nullptr
+	 * @param size 字节数
+	 */
+	void addData(const char *data, int size)
+	{
+		if (size <= 0)
+		{
+			// memcpy 的源指针即使长度为 0 也不能为空
+			return;
+		}
+		const uchar *p = reinterpret_cast<const uchar *>(data);
+		const uchar *end = p + size;
+		m_length += static_cast<quint64>(size);
+		if (m_buffered + size < 32)
+		{
+			std::memcpy(m_buffer + m_buffered, p, static_cast<std::size_t>(size));
+			m_buffered += size;
+			return;
+		}
+		if (m_buffered > 0)
+		{
+			const int fill = 32 - m_buffered;
+			std::memcpy(m_buffer + m_buffered, p, static_cast<std::size_t>(fill));
+			consume(m_buffer);
+			p += fill;
+			m_buffered = 0;
+		}
+		for (; end - p >= 32; p += 32)
+		{
+			consume(p);
+		}
+		m_buffered = static_cast<int>(end - p);
+		std::memcpy(m_buffer, p, static_cast<std::size_t>(m_buffered));
+	}
+
+	void addData(const QByteArray &data)
+	{
+		addData(data.constData(), data.size());
+	}
+
+	/**
+	 * @brief 当前输入的哈希值，不影响后续追加
+	 */
+	quint64 result() const
+	{
+		quint64 h;
+		if (m_length >= 32)
+		{
+			h = rotl(m_v[0], 1) + rotl(m_v[1], 7) + rotl(m_v[2], 12) + rotl(m_v[3], 18);
+			for (quint64 v : m_v)
+			{
+				h ^= round(0, v);
+				h = h * Prime1 + Prime4;
+			}
+		}
+		else
+		{
+			h = m_seed + Prime5;
+		}
+		h += m_length;
+
+		const uchar *p = m_buffer;
+		const uchar *end = m_buffer + m_buffered;
+		for (; end - p >= 8; p += 8)
+		{
+			h ^= round(0, qFromLittleEndian<quint64>(p));
+			h = rotl(h, 27) * Prime1 + Prime4;
+		}
+		if (end - p >= 4)
+		{
+			h ^= static_cast<quint64>(qFromLittleEndian<quint32>(p)) * Prime1;
+			h = rotl(h, 23) * Prime2 + Prime3;
+			p += 4;
+		}
+		for (; p < end; p++)
+		{
+			h ^= *p * Prime5;
+			h = rotl(h, 11) * Prime1;
+		}
+
+		h ^= h >> 33;
+		h *= Prime2;
+		h ^= h >> 29;
+		h *= Prime3;
+		h ^= h >> 32;
+		return h;
+	}
+
+	/**
+	 * @brief 计算一段字节的哈希值
+	 */
+	static quint64 hash(const QByteArray &data, quint64 seed = 0)
+	{
+		JsonHash64 hasher(seed);
+		hasher.addData(data);
+		return hasher.result();
+	}
+
+private:
+	static constexpr quint64 Prime1 = Q_UINT64_C(0x9E3779B185EBCA87);
+	static constexpr quint64 Prime2 = Q_UINT64_C(0xC2B2AE3D27D4EB4F);
+	static constexpr quint64 Prime3 = Q_UINT64_C(0x165667B19E3779F9);
+	static constexpr quint64 Prime4 = Q_UINT64_C(0x85EBCA77C2B2AE63);
+	static constexpr quint64 Prime5 = Q_UINT64_C(0x27D4EB2F165667C5);
+
+	static quint64 rotl(quint64 value, int bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	static quint64 round(quint64 accumulator, quint64 input)
+	{
+		accumulator += input * Prime2;
+		accumulator = rotl(accumulator, 31);
+		return accumulator * Prime1;
+	}
+
+	void consume(const uchar *stripe)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			m_v[i] = round(m_v[i], qFromLittleEndian<quint64>(stripe + i * 8));
+		}
+	}
+
+	quint64 m_seed;
+	quint64 m_v[4];
+	quint64 m_length = 0;
+	uchar m_buffer[32];
+	int m_buffered = 0;
+};
+
+/**
+ * @brief 对象的结构指纹
+ * @details
+ * 以 JsonWriter 遍历与序列化相同的属性元数据和 Serializer<T> 层次，输出分段送入流式哈希，
+ * 不生成完整的 JSON 文档，内存占用与对象大小无关
+ * 哈希的输入是规范 JSON：紧凑格式、键按升序、使用完整键名（忽略 JsonCompactKeysScope），
+ * 浮点数以完整精度输出（忽略全局策略与 JsonFloatPrecisionScope，属性自身声明的精度仍然生效）；
+ * 因此在默认精度下 of(value) == ofJson(JsonWriter::serialize(value))，
+ * 其他语言按同样规则生成规范 JSON 后也能得到相同的指纹
+ * 数字的文本形式由 Qt 决定：同一 Qt 主版本下指纹跨进程、跨平台稳定；
+ * Qt 5 与 Qt 6 的浮点数格式化不同，Qt 5 的 QJsonValue 以 double 保存整数，
+ * 含浮点数或绝对值超过 2^53 的整数的值在两个版本下的指纹可能不同，持久化的指纹不应跨 Qt 主版本比较
+ * @code
+ * quint64 key = JsonFingerprint::of(pagedPerson);
+ * @endcode
+ */
+struct JsonFingerprint
+{
+	/**
+	 * @brief 计算值的指纹
+	 * @tparam T 可序列化的值类型
+	 * @param value 值
+	 * @param seed 哈希种子
+	 * @return quint64 指纹
+	 */
+	template <typename T>
+	static quint64 of(const T &value, quint64 seed = 0)
+	{
+		JsonCompactKeysScope keysScope(false);
+		JsonFloatPrecisionScope precisionScope(JsonFloatPrecision::full());
+		JsonHash64 hasher(seed);
+		QByteArray buffer;
+		JsonWriter writer(buffer);
+		writer.setSink([&hasher](const char *data, int size) { hasher.addData(data, size); });
+		writer.write(value);
+		writer.flush();
+		return hasher.result();
+	}
+
+	/**
+	 * @brief 计算规范 JSON 字节数据的指纹
+	 * @param json 紧凑、键按升序的 JSON 字节数据
+	 * @param seed 哈希种子
+	 * @return quint64 指纹
+	 */
+	static quint64 ofJson(const QByteArray &json, quint64 seed = 0)
+	{
+		return JsonHash64::hash(json, seed);
+	}
+};
+
+#endif // JSON_SERIALIZER_FINGERPRINT_H
@@ -0,0 +1,846 @@
+// File: JsonSerializerIncremental
+// Author: linxmouse@gmail.com
+// Creation: 2024/09/29
+#ifndef JSON_SERIALIZER_INCREMENTAL_H
+#define JSON_SERIALIZER_INCREMENTAL_H
+
+#include "JsonSerializer.h"
+
+#include <deque>
+#include <optional>
+
+/**
+ * @brief 增量结构扫描器
+ * @details
+ * 逐块接收输入字节，跟踪嵌套深度与字符串状态，在根容器的第一层切分出完整的成员或元素：
+ * 根为对象时每一项是一个 "key": value 成员，根为数组时每一项是一个元素，根为标量时整个值是一项
+ * 根对象中值为对象数组的成员（例如分页结果中的记录列表）再往下切分一层：
+ * 依次产生 ArrayBegin（内容为带引号的键）、每个元素一项 ArrayElement 与 ArrayEnd，
+ * 因此单个大数组成员也不需要整体缓存；更深层的数组与非对象元素的数组仍随所在的项整体切分
+ * 只保留当前未完成项的字节，已切分的项取走后即可释放，不需要缓存整个文档
+ * 不做完整的语法校验，项的内容由 QJsonDocument 解析时校验
+ */
+class JsonStreamScanner
+{
+public:
+	enum Root
+	{
+		Unknown, ///< 尚未读到根值
+		Object,  ///< 根为对象
+		Array,   ///< 根为数组
+		Scalar   ///< 根为标量
+	};
+
+	enum Kind
+	{
+		Value,        ///< 根容器第一层的成员或元素，或标量根的值
+		ArrayBegin,   ///< 根对象中对象数组成员的开始，内容为带引号的键
+		ArrayElement, ///< 对象数组成员中的一个元素
+		ArrayEnd      ///< 对象数组成员的结束，内容为空
+	};
+
+	struct Item
+	{
+		Kind kind;
+		QByteArray data; ///< 去掉首尾空白的项内容
+	};
+
+	/**
+	 * @brief 输入一块字节
+	 * @param data 字节数据
+	 * @param size 字节数
+	 */
+	void feed(const char *data, int size)
+	{
+		int start = m_root != Unknown && !m_finished ? 0 : -1;
+		for (int i = 0; i < size; ++i)
+		{
+			const char c = data[i];
+			if (m_finished)
+			{
+				if (!isSpace(c))
+				{
+					m_error = true;
+				}
+				continue;
+			}
+			if (m_inString)
+			{
+				if (m_escape)
+				{
+					m_escape = false;
+				}
+				else if (c == '\\')
+				{
+					m_escape = true;
+				}
+				else if (c == '"')
+				{
+					m_inString = false;
+				}
+				continue;
+			}
+			if (m_root == Unknown)
+			{
+				if (isSpace(c))
+				{
+					continue;
+				}
+				if (c == '{' || c == '[')
+				{
+					m_root = c == '{' ? Object : Array;
+					m_depth = 1;
+					start = i + 1;
+					continue;
+				}
+				m_root = Scalar;
+				start = i;
+			}
+			if (m_arrayStart && !isSpace(c))
+			{
+				// 成员数组的第一个元素是对象时才逐个元素切分
+				m_arrayStart = false;
+				if (c == '{')
+				{
+					m_pending.append(data + start, i - start);
+					beginArray();
+					start = i;
+				}
+			}
+			if (m_colon && !isSpace(c))
+			{
+				m_colon = false;
+				m_arrayStart = c == '[';
+			}
+			switch (c)
+			{
+			case '"':
+				m_inString = true;
+				break;
+			case ':':
+				if (m_root == Object && m_depth == 1)
+				{
+					m_colon = true;
+				}
+				break;
+			case '{':
+			case '[':
+				m_depth++;
+				break;
+			case '}':
+			case ']':
+				if (m_root == Scalar)
+				{
+					break;
+				}
+				if (--m_depth == 1 && m_nested)
+				{
+					if (c != ']')
+					{
+						m_error = true;
+					}
+					flush(ArrayElement, data + start, i - start);
+					m_items.push_back({ArrayEnd, QByteArray()});
+					m_nested = false;
+					start = i + 1;
+				}
+				else if (m_depth == 0)
+				{
+					if (c != (m_root == Object ? '}' : ']'))
+					{
+						m_error = true;
+					}
+					flush(Value, data + start, i - start);
+					start = -1;
+					m_finished = true;
+				}
+				break;
+			case ',':
+				if (m_root == Scalar)
+				{
+					// 标量根之后不能再有其它值
+					m_error = true;
+				}
+				else if (m_nested && m_depth == 2)
+				{
+					flush(ArrayElement, data + start, i - start);
+					start = i + 1;
+				}
+				else if (m_depth == 1)
+				{
+					flush(Value, data + start, i - start);
+					start = i + 1;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		if (start >= 0)
+		{
+			m_pending.append(data + start, size - start);
+		}
+	}
+
+	/**
+	 * @brief 输入结束
+	 * @details 根为标量时此时才切分出该值；根容器未闭合或没有任何输入时标记为错误
+	 */
+	void finish()
+	{
+		if (m_root == Scalar && !m_finished)
+		{
+			flush(Value, nullptr, 0);
+			m_finished = true;
+		}
+		if (!m_finished || m_inString)
+		{
+			m_error = true;
+		}
+	}
+
+	Root root() const
+	{
+		return m_root;
+	}
+
+	/**
+	 * @brief 根值是否已经完整读入
+	 */
+	bool isFinished() const
+	{
+		return m_finished;
+	}
+
+	bool hasError() const
+	{
+		return m_error;
+	}
+
+	bool hasItem() const
+	{
+		return !m_items.empty();
+	}
+
+	/**
+	 * @brief 取走最早切分出的一项
+	 */
+	Item takeItem()
+	{
+		Item item = std::move(m_items.front());
+		m_items.pop_front();
+		return item;
+	}
+
+private:
+	static bool isSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	void flush(Kind kind, const char *data, int size)
+	{
+		m_pending.append(data, size);
+		QByteArray item = m_pending.trimmed();
+		m_pending.clear();
+		if (!item.isEmpty())
+		{
+			m_items.push_back({kind, std::move(item)});
+		}
+	}
+
+	/**
+	 * @brief 进入成员数组，m_pending 中是 "key": [ 部分
+	 */
+	void beginArray()
+	{
+		const int colon = m_pending.lastIndexOf(':');
+		m_items.push_back({ArrayBegin, m_pending.left(colon).trimmed()});
+		m_pending.clear();
+		m_nested = true;
+	}
+
+	Root m_root = Unknown;
+	int m_depth = 0;
+	bool m_inString = false;
+	bool m_escape = false;
+	bool m_finished = false;
+	bool m_error = false;
+	bool m_colon = false;      ///< 根对象的成员已读到冒号，等待值的第一个字符
+	bool m_arrayStart = false; ///< 成员的值是数组，等待第一个元素的第一个字符
+	bool m_nested = false;     ///< 正在逐个元素切分成员数组
+	QByteArray m_pending;
+	std::deque<Item> m_items;
+};
+
+/**
+ * @brief 序列容器判断
+ */
+template <typename T>
+struct JsonIsSequence : std::false_type
+{
+};
+
+template <typename T>
+struct JsonIsSequence<QList<T>> : std::true_type
+{
+};
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+template <typename T>
+struct JsonIsSequence<QVector<T>> : std::true_type
+{
+};
+#endif
+
+template <typename T>
+struct JsonIsSequence<std::vector<T>> : std::true_type
+{
+};
+
+/**
+ * @brief 增量解码器
+ * @tparam T 目标类型
+ * @details
+ * 每当扫描器切分出一项就立即解码并写入目标：
+ * 可序列化类逐个成员写入，序列容器逐个元素追加，其余类型先累积为 JSON 树、输入结束时再整体转换
+ * 可序列化类中以默认编解码的序列容器成员（例如 TestPagedPerson::persons）经由 JsonFieldAccess
+ * 逐个元素追加；其余成员数组的元素先缓存，数组结束时作为一个完整成员写入
+ * 部分构建的对象保存在解码器中，输入只需缓存当前未完成的一项
+ * 不依赖协程，C++17 下可以同步地逐块调用 feed()
+ * @code
+ * JsonIncrementalDecoder<TestPagedPerson> decoder;
+ * decoder.feed(socket->readAll());   // 数据到达时反复调用
+ * if (decoder.finish()) { TestPagedPerson paged = decoder.takeValue(); }
+ * @endcode
+ */
+template <typename T>
+class JsonIncrementalDecoder
+{
+public:
+	/**
+	 * @brief 输入一块字节并解码其中已经完整的项
+	 * @param chunk 字节数据
+	 */
+	void feed(const QByteArray &chunk)
+	{
+		m_scanner.feed(chunk.constData(), chunk.size());
+		drain();
+	}
+
+	/**
+	 * @brief 结束输入
+	 * @return bool 输入完整且各项都能解析时返回 true
+	 */
+	bool finish()
+	{
+		if (!m_scanner.isFinished())
+		{
+			m_scanner.finish();
+			drain();
+		}
+		if (!m_converted)
+		{
+			m_converted = true;
+			switch (m_scanner.root())
+			{
+			case JsonStreamScanner::Object:
+				if (!m_memberwise)
+				{
+					m_value = Serializer<T>::fromJson(m_object);
+				}
+				break;
+			case JsonStreamScanner::Array:
+				if (!m_elementwise)
+				{
+					m_value = Serializer<T>::fromJson(m_array);
+				}
+				break;
+			case JsonStreamScanner::Scalar:
+				// 标量根只能是单个值，其后的多余内容视为错误
+				if (m_array.size() != 1)
+				{
+					m_error = true;
+				}
+				m_value = Serializer<T>::fromJson(m_array.isEmpty() ? QJsonValue() : m_array.at(0));
+				break;
+			default:
+				break;
+			}
+		}
+		return !hasError();
+	}
+
+	/**
+	 * @brief 根值是否已经完整读入
+	 */
+	bool isFinished() const
+	{
+		return m_scanner.isFinished();
+	}
+
+	bool hasError() const
+	{
+		return m_error || m_scanner.hasError();
+	}
+
+	/**
+	 * @brief 当前（可能尚未完整）的解码结果
+	 */
+	T &value()
+	{
+		return m_value;
+	}
+
+	T takeValue()
+	{
+		return std::move(m_value);
+	}
+
+private:
+	void drain()
+	{
+		while (m_scanner.hasItem())
+		{
+			apply(m_scanner.takeItem());
+		}
+	}
+
+	void apply(const JsonStreamScanner::Item &item)
+	{
+		switch (item.kind)
+		{
+		case JsonStreamScanner::ArrayBegin:
+			beginArray(item.data);
+			break;
+		case JsonStreamScanner::ArrayElement:
+			appendElement(item.data);
+			break;
+		case JsonStreamScanner::ArrayEnd:
+			endArray();
+			break;
+		default:
+			applyValue(item.data);
+			break;
+		}
+	}
+
+	/**
+	 * @brief 开始一个成员数组
+	 * @details 能逐个元素追加时先清空成员，否则开始缓存元素
+	 * @param key 带引号的键
+	 */
+	void beginArray(const QByteArray &key)
+	{
+		m_arrayKey = key;
+		m_arrayAccess = nullptr;
+		m_arrayElements.clear();
+		if constexpr (IsJsonSerializable<T>::value)
+		{
+			QJsonDocument document;
+			if (!parse('[', key, ']', document))
+			{
+				return;
+			}
+			const JsonPropertyTable &table = JsonPropertyTable::of<T>();
+			const int index = table.indexOf(document.array().at(0).toString(), m_position++);
+			const JsonFieldAccess *access = index >= 0 ? table.entries().at(index).access : nullptr;
+			if (access && access->clearSequence(&m_value))
+			{
+				m_memberwise = true;
+				m_arrayAccess = access;
+			}
+		}
+	}
+
+	void appendElement(const QByteArray &element)
+	{
+		if (!m_arrayAccess)
+		{
+			if (!m_arrayElements.isEmpty())
+			{
+				m_arrayElements.append(',');
+			}
+			m_arrayElements.append(element);
+			return;
+		}
+		QJsonDocument document;
+		if (parse('[', element, ']', document))
+		{
+			m_arrayAccess->appendElement(&m_value, document.array().at(0));
+		}
+	}
+
+	void endArray()
+	{
+		if (!m_arrayAccess)
+		{
+			QByteArray member = m_arrayKey;
+			member.append(":[");
+			member.append(m_arrayElements);
+			member.append(']');
+			applyValue(member);
+		}
+		m_arrayAccess = nullptr;
+		m_arrayKey.clear();
+		m_arrayElements.clear();
+	}
+
+	void applyValue(const QByteArray &item)
+	{
+		if (m_scanner.root() == JsonStreamScanner::Object)
+		{
+			QJsonDocument document;
+			if (!parse('{', item, '}', document))
+			{
+				return;
+			}
+			if constexpr (IsJsonSerializable<T>::value)
+			{
+				// 属性表只写入出现的键，逐个成员写入即可得到与整体解码相同的结果
+				m_memberwise = true;
+				const JsonPropertyTable &table = JsonPropertyTable::of<T>();
+				const QJsonObject member = document.object();
+				if (table.hasGeneratedCodec())
+				{
+					m_value.fromJson(QJsonValue(member));
+					m_position += member.size();
+					return;
+				}
+				for (auto it = member.constBegin(); it != member.constEnd(); ++it)
+				{
+					// 成员按文档中的顺序到达，以其位置推测属性
+					const int index = table.indexOf(it.key(), m_position++);
+					if (index >= 0)
+					{
+						table.entries().at(index).property.writeOnGadget(&m_value, it.value());
+					}
+				}
+			}
+			else
+			{
+				const QJsonObject member = document.object();
+				for (auto it = member.constBegin(); it != member.constEnd(); ++it)
+				{
+					m_object.insert(it.key(), it.value());
+				}
+			}
+			return;
+		}
+
+		QJsonDocument document;
+		if (!parse('[', item, ']', document))
+		{
+			return;
+		}
+		QJsonValue element = document.array().at(0);
+		if constexpr (JsonIsSequence<T>::value)
+		{
+			if (m_scanner.root() == JsonStreamScanner::Array)
+			{
+				using Element = typename std::decay<decltype(*m_value.begin())>::type;
+				m_elementwise = true;
+				m_value.push_back(Serializer<Element>::fromJson(element));
+				return;
+			}
+		}
+		m_array.append(element);
+	}
+
+	bool parse(char open, const QByteArray &item, char close, QJsonDocument &document)
+	{
+		QByteArray wrapped;
+		wrapped.reserve(item.size() + 2);
+		wrapped.append(open);
+		wrapped.append(item);
+		wrapped.append(close);
+		QJsonParseError error;
+		document = QJsonDocument::fromJson(wrapped, &error);
+		if (error.error != QJsonParseError::NoError)
+		{
+			m_error = true;
+			return false;
+		}
+		return true;
+	}
+
+	JsonStreamScanner m_scanner;
+	T m_value{};
+	QJsonObject m_object;
+	QJsonArray m_array;
+	QByteArray m_arrayKey;                         ///< 当前成员数组带引号的键
+	QByteArray m_arrayElements;                    ///< 不能逐个追加时缓存的元素，以逗号分隔
+	const JsonFieldAccess *m_arrayAccess = nullptr; ///< 逐个追加元素时使用的成员访问接口
+	int m_position = 0;                            ///< 下一个根对象成员在文档中的位置，用于键序推测
+	bool m_memberwise = false;
+	bool m_elementwise = false;
+	bool m_converted = false;
+	bool m_error = false;
+};
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#define JSON_SERIALIZER_HAS_COROUTINES 1
+#include <coroutine>
+#include <exception>
+
+/**
+ * @brief 协程使用的输入块通道
+ * @details
+ * 数据源（例如套接字的 readyRead 槽）调用 push() 送入数据、close() 表示输入结束；
+ * 解码协程 co_await next() 取得下一块，没有数据时挂起，push() 时在调用方线程中恢复执行
+ * 通道本身不加锁，push()/close() 应与协程在同一线程中调用，少量线程即可驱动大量并发的解码
+ */
+class JsonChunkChannel
+{
+public:
+	JsonChunkChannel() = default;
+	JsonChunkChannel(const JsonChunkChannel &) = delete;
+	JsonChunkChannel &operator=(const JsonChunkChannel &) = delete;
+
+	void push(QByteArray chunk)
+	{
+		if (m_closed)
+		{
+			return;
+		}
+		m_chunks.push_back(std::move(chunk));
+		resume();
+	}
+
+	void close()
+	{
+		m_closed = true;
+		resume();
+	}
+
+	/**
+	 * @brief 等待下一块输入
+	 * @return 可等待对象，结果为 std::optional<QByteArray>，输入结束时为空
+	 */
+	auto next()
+	{
+		struct Awaiter
+		{
+			JsonChunkChannel &channel;
+			std::coroutine_handle<> suspended;
+
+			// 挂起中的协程被销毁时（例如任务对象提前析构）撤销等待，通道不再恢复已销毁的协程帧
+			~Awaiter()
+			{
+				if (suspended && channel.m_waiter == suspended)
+				{
+					channel.m_waiter = nullptr;
+				}
+			}
+
+			bool await_ready() const noexcept
+			{
+				return !channel.m_chunks.empty() || channel.m_closed;
+			}
+
+			void await_suspend(std::coroutine_handle<> handle) noexcept
+			{
+				suspended = handle;
+				channel.m_waiter = handle;
+			}
+
+			std::optional<QByteArray> await_resume()
+			{
+				if (channel.m_chunks.empty())
+				{
+					return std::nullopt;
+				}
+				QByteArray chunk = std::move(channel.m_chunks.front());
+				channel.m_chunks.pop_front();
+				return chunk;
+			}
+		};
+		return Awaiter{*this, nullptr};
+	}
+
+private:
+	void resume()
+	{
+		if (std::coroutine_handle<> waiter = std::exchange(m_waiter, nullptr))
+		{
+			waiter.resume();
+		}
+	}
+
+	std::deque<QByteArray> m_chunks;
+	std::coroutine_handle<> m_waiter;
+	bool m_closed = false;
+};
+
+/**
+ * @brief 解码协程的任务对象
+ * @tparam T 目标类型
+ * @details
+ * 协程创建后立即运行到第一次等待输入；结果为 std::optional<T>，输入不完整或格式错误时为空
+ * 可以在其他协程中 co_await，也可以轮询 isReady() 后读取 result()
+ * 任务对象析构时销毁协程帧；协程正在等待通道时同时撤销等待，之后的 push()/close() 不会再恢复它
+ */
+template <typename T>
+class JsonDecodeTask
+{
+public:
+	struct promise_type
+	{
+		std::optional<T> value;
+		std::coroutine_handle<> continuation;
+
+		JsonDecodeTask get_return_object()
+		{
+			return JsonDecodeTask(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_never initial_suspend() noexcept
+		{
+			return {};
+		}
+
+		auto final_suspend() noexcept
+		{
+			struct FinalAwaiter
+			{
+				bool await_ready() const noexcept
+				{
+					return false;
+				}
+
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+				{
+					std::coroutine_handle<> continuation = handle.promise().continuation;
+					return continuation ? continuation : std::noop_coroutine();
+				}
+
+				void await_resume() const noexcept
+				{
+				}
+			};
+			return FinalAwaiter{};
+		}
+
+		void return_value(std::optional<T> result)
+		{
+			value = std::move(result);
+		}
+
+		void unhandled_exception()
+		{
+			std::terminate();
+		}
+	};
+
+	JsonDecodeTask(JsonDecodeTask &&other) noexcept
+		: m_handle(std::exchange(other.m_handle, nullptr))
+	{
+	}
+
+	JsonDecodeTask &operator=(JsonDecodeTask &&other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			m_handle = std::exchange(other.m_handle, nullptr);
+		}
+		return *this;
+	}
+
+	~JsonDecodeTask()
+	{
+		reset();
+	}
+
+	/**
+	 * @brief 解码是否已经结束
+	 */
+	bool isReady() const
+	{
+		return m_handle && m_handle.done();
+	}
+
+	/**
+	 * @brief 解码结果，仅在 isReady() 为 true 时有效
+	 */
+	std::optional<T> &result()
+	{
+		return m_handle.promise().value;
+	}
+
+	bool await_ready() const noexcept
+	{
+		return isReady();
+	}
+
+	void await_suspend(std::coroutine_handle<> continuation) noexcept
+	{
+		m_handle.promise().continuation = continuation;
+	}
+
+	std::optional<T> await_resume()
+	{
+		return std::move(m_handle.promise().value);
+	}
+
+private:
+	explicit JsonDecodeTask(std::coroutine_handle<promise_type> handle)
+		: m_handle(handle)
+	{
+	}
+
+	void reset()
+	{
+		if (m_handle)
+		{
+			m_handle.destroy();
+			m_handle = nullptr;
+		}
+	}
+
+	std::coroutine_handle<promise_type> m_handle;
+};
+
+/**
+ * @brief 基于协程的增量解码
+ * @details
+ * 解码状态（扫描器与部分构建的对象）保存在协程帧中，等待输入时不占用线程
+ * @code
+ * JsonChunkChannel channel;
+ * JsonDecodeTask<TestPagedPerson> task = JsonCoroutine::decode<TestPagedPerson>(channel);
+ * connect(socket, &QTcpSocket::readyRead, [&] { channel.push(socket->readAll()); });
+ * connect(socket, &QTcpSocket::disconnected, [&] { channel.close(); });
+ * @endcode
+ */
+struct JsonCoroutine
+{
+	/**
+	 * @brief 从通道读取并解码一个 JSON 值
+	 * @details 根值读完即结束，不需要等待通道关闭
+	 * @tparam T 目标类型
+	 * @param channel 输入块通道，需在任务结束前保持有效
+	 * @return JsonDecodeTask<T> 解码任务
+	 */
+	template <typename T>
+	static JsonDecodeTask<T> decode(JsonChunkChannel &channel)
+	{
+		JsonIncrementalDecoder<T> decoder;
+		while (!decoder.isFinished() && !decoder.hasError())
+		{
+			std::optional<QByteArray> chunk = co_await channel.next();
+			if (!chunk)
+			{
+				break;
+			}
+			decoder.feed(*chunk);
+		}
+		if (!decoder.finish())
+		{
+			co_return std::nullopt;
+		}
+		co_return decoder.takeValue();
+	}
+};
+#endif
+
+#endif // JSON_SERIALIZER_INCREMENTAL_H
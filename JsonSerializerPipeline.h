@@ -0,0 +1,848 @@
+// File: JsonSerializerPipeline
+// Author: linxmouse@gmail.com
+// Creation: 2024/09/29
+#ifndef JSON_SERIALIZER_PIPELINE_H
+#define JSON_SERIALIZER_PIPELINE_H
+
+#include "JsonSerializerIncremental.h"
+
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief 有界无锁多生产者多消费者队列
+ * @tparam T 元素类型（可移动）
+ * @details 基于每个槽位序号的环形缓冲区，入队与出队各用一次 CAS，满或空时立即返回 false 而不阻塞
+ */
+template <typename T>
+class JsonBoundedQueue
+{
+public:
+	/**
+	 * @param capacity 容量，向上取整为 2 的幂
+	 */
+	explicit JsonBoundedQueue(std::size_t capacity)
+	{
+		std::size_t size = 2;
+		while (size < capacity)
+		{
+			size <<= 1;
+		}
+		m_mask = size - 1;
+		m_cells.reset(new Cell[size]);
+		for (std::size_t i = 0; i < size; i++)
+		{
+			m_cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	JsonBoundedQueue(const JsonBoundedQueue &) = delete;
+	JsonBoundedQueue &operator=(const JsonBoundedQueue &) = delete;
+
+	/**
+	 * @brief 尝试入队
+	 * @param value 成功时被移入队列，失败时保持不变
+	 * @return bool 队列已满时返回 false
+	 */
+	bool tryPush(T &value)
+	{
+		std::size_t position = m_enqueue.load(std::memory_order_relaxed);
+		Cell *cell;
+		for (;;)
+		{
+			cell = &m_cells[position & m_mask];
+			std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+			if (difference == 0)
+			{
+				if (m_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (difference < 0)
+			{
+				return false;
+			}
+			else
+			{
+				position = m_enqueue.load(std::memory_order_relaxed);
+			}
+		}
+		cell->value = std::move(value);
+		cell->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief 尝试出队
+	 * @param value 成功时接收队首元素
+	 * @return bool 队列为空时返回 false
+	 */
+	bool tryPop(T &value)
+	{
+		std::size_t position = m_dequeue.load(std::memory_order_relaxed);
+		Cell *cell;
+		for (;;)
+		{
+			cell = &m_cells[position & m_mask];
+			std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+			if (difference == 0)
+			{
+				if (m_dequeue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (difference < 0)
+			{
+				return false;
+			}
+			else
+			{
+				position = m_dequeue.load(std::memory_order_relaxed);
+			}
+		}
+		value = std::move(cell->value);
+		cell->sequence.store(position + m_mask + 1, std::memory_order_release);
+		return true;
+	}
+
+private:
+	struct Cell
+	{
+		std::atomic<std::size_t> sequence;
+		T value;
+	};
+
+	std::unique_ptr<Cell[]> m_cells;
+	std::size_t m_mask = 0;
+	alignas(64) std::atomic<std::size_t> m_enqueue{0};
+	alignas(64) std::atomic<std::size_t> m_dequeue{0};
+};
+
+/**
+ * @brief 序列容器的元素类型，非序列类型为 int 占位
+ */
+template <typename T, bool = JsonIsSequence<T>::value>
+struct JsonSequenceElement
+{
+	using type = int;
+};
+
+template <typename T>
+struct JsonSequenceElement<T, true>
+{
+	using type = typename T::value_type;
+};
+
+/**
+ * @brief 流水线解码参数
+ */
+struct JsonPipelineOptions
+{
+	int workers = 0;           ///< 解码线程数，0 表示硬件线程数减一（至少为 1）
+	int chunkBytes = 1 << 18;  ///< 数组切分的粒度（字节）；小于该值的文档直接在调用线程中解码
+	int blockSize = 16;        ///< 每次交给解码线程的最多项数
+	int queueCapacity = 64;    ///< 分词与解码两级之间队列的容量（块数）
+};
+
+/**
+ * @brief 单个大文档的流水线解码
+ * @tparam T 目标类型：可序列化类（根为对象）或序列容器（根为数组）
+ * @details
+ * 调用线程运行结构分词：跟踪嵌套深度与字符串状态，把文档切分为互不依赖的子树区间，
+ * 按块经由 JsonBoundedQueue 交给解码线程；解码线程解析各自的区间并构建对象：
+ * - 根为对象时每个成员是一项，解码线程直接通过属性的 setter 写入目标，不同成员并行写入；
+ *   成员值是超过 chunkBytes 的数组时再按元素切分，各段并行解析；成员是以默认编解码的序列容器时，
+ *   解析该段的线程同时把元素解码为成员的元素类型（见 JsonFieldAccess::decodeElements()），
+ *   最后一段完成的线程按顺序移动拼接后写入该成员；其余成员数组按顺序拼接为 JSON 数组后经由 setter 写入
+ * - 根为数组时元素按 chunkBytes 分段，各段并行解码为元素，全部完成后按原顺序拼接
+ * 同名键（包括不区分大小写、短键名指向同一属性的情况）以文档中靠后的为准，与 fromJson() 一致
+ * 文档整体必须已在内存中；解码期间 data 不能被修改
+ * @code
+ * TestPagedPerson paged;
+ * bool ok = JsonPipelineDecoder<TestPagedPerson>::decode(data, paged);
+ * @endcode
+ */
+template <typename T>
+class JsonPipelineDecoder
+{
+	static_assert(IsJsonSerializable<T>::value || JsonIsSequence<T>::value, "pipeline decoding requires a serializable class or a sequence container");
+
+public:
+	/**
+	 * @brief 解码文档
+	 * @details 根为对象时只写入文档中出现的属性；根为数组时替换 value 的全部元素
+	 * @param data JSON 字节数据
+	 * @param value 目标对象
+	 * @param options 流水线参数
+	 * @return bool 文档结构完整且各项均解析成功时返回 true；失败时 value 可能已被部分写入
+	 */
+	static bool decode(const QByteArray &data, T &value, const JsonPipelineOptions &options = JsonPipelineOptions())
+	{
+		int workers = options.workers > 0 ? options.workers : std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+		if (data.size() < options.chunkBytes)
+		{
+			return decodeSerial(data, value);
+		}
+
+		JsonPipelineDecoder decoder(data, value, options);
+		// 自动短键名只在短键名作用域中接受，解码线程沿用调用线程的设置
+		const bool compact = JsonCompactKeysScope::active();
+		std::vector<std::thread> threads;
+		threads.reserve(workers);
+		for (int i = 0; i < workers; i++)
+		{
+			threads.emplace_back([&decoder, compact]() {
+				JsonCompactKeysScope keysScope(compact);
+				decoder.work();
+			});
+		}
+		decoder.tokenize();
+		decoder.m_done.store(true, std::memory_order_release);
+		for (std::thread &thread : threads)
+		{
+			thread.join();
+		}
+		if constexpr (JsonIsSequence<T>::value)
+		{
+			decoder.assemble();
+		}
+		return !decoder.m_error.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief 解码文档并返回新对象
+	 * @param data JSON 字节数据
+	 * @param options 流水线参数
+	 * @return T 解码结果，失败时为部分写入的对象
+	 */
+	static T fromJson(const QByteArray &data, const JsonPipelineOptions &options = JsonPipelineOptions())
+	{
+		T value;
+		decode(data, value, options);
+		return value;
+	}
+
+private:
+	using Element = typename JsonSequenceElement<T>::type;
+	using Elements = std::vector<Element>;
+
+	/**
+	 * @brief 成员数组的一段
+	 */
+	struct SplitPart
+	{
+		QJsonArray array;              ///< 解析结果，已解码为 elements 时清空
+		std::shared_ptr<void> elements; ///< 按成员类型解码的元素，见 JsonFieldAccess::decodeElements()
+	};
+
+	/**
+	 * @brief 被切分的成员数组
+	 * @details pending 包含分词线程自身的一个引用，计数归零的线程负责拼接并写入
+	 */
+	struct Split
+	{
+		int keyBegin;
+		int keyEnd;
+		int ordinal;
+		const JsonFieldAccess *access; ///< 成员的访问接口，没有时各段只解析为 JSON 数组
+		std::deque<SplitPart> parts;
+		std::atomic<int> pending{1};
+	};
+
+	/**
+	 * @brief 分词产生的一项：完整成员，或数组的一段元素
+	 */
+	struct Entry
+	{
+		int keyBegin;       ///< 成员键（含引号）的起始位置
+		int keyEnd;         ///< 成员键的结束位置
+		int begin;          ///< 值或元素段的起始位置
+		int end;            ///< 值或元素段的结束位置
+		int ordinal;        ///< 成员在文档中的序号
+		Split *split;       ///< 成员数组的一段，非空时写入 part
+		SplitPart *part;    ///< 成员数组一段的解码结果
+		Elements *elements; ///< 根数组一段的解码结果
+	};
+
+	using Block = std::vector<Entry>;
+
+	JsonPipelineDecoder(const QByteArray &data, T &value, const JsonPipelineOptions &options)
+		: m_data(data), m_value(value), m_options(options), m_queue(static_cast<std::size_t>(std::max(2, options.queueCapacity)))
+	{
+		if constexpr (IsJsonSerializable<T>::value)
+		{
+			m_table = &JsonPropertyTable::of<T>();
+			m_locks.reset(new std::mutex[m_table->entries().size()]);
+			m_ordinals.assign(m_table->entries().size(), -1);
+		}
+	}
+
+	static bool decodeSerial(const QByteArray &data, T &value)
+	{
+		QJsonParseError error;
+		QJsonDocument document = QJsonDocument::fromJson(data, &error);
+		if (error.error != QJsonParseError::NoError)
+		{
+			return false;
+		}
+		if constexpr (IsJsonSerializable<T>::value)
+		{
+			value.fromJson(QJsonValue(document.object()));
+			return document.isObject();
+		}
+		else
+		{
+			value = Serializer<T>::fromJson(document.array());
+			return document.isArray();
+		}
+	}
+
+	static bool isSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	/**
+	 * @brief 分词：在调用线程中扫描整个文档并按块入队
+	 */
+	void tokenize()
+	{
+		const char *data = m_data.constData();
+		const int size = m_data.size();
+		const int chunk = std::max(1, m_options.chunkBytes);
+		int i = 0;
+		while (i < size && isSpace(data[i]))
+		{
+			i++;
+		}
+		const bool objectRoot = i < size && data[i] == '{';
+		if (i >= size || (IsJsonSerializable<T>::value ? !objectRoot : data[i] != '['))
+		{
+			m_error.store(true, std::memory_order_relaxed);
+			return;
+		}
+
+		int depth = 1;
+		bool inString = false;
+		bool escape = false;
+		int stringBegin = -1;
+		// 根对象的成员状态
+		bool expectKey = true;
+		bool valueStarted = false;
+		int keyBegin = -1;
+		int keyEnd = -1;
+		int valueBegin = -1;
+		int ordinal = 0;
+		bool splitting = false;
+		Split *split = nullptr;
+		bool memberSplit = false;
+		// 当前数组段的起始位置
+		int chunkBegin = objectRoot ? -1 : i + 1;
+
+		for (i++; i < size && depth > 0; i++)
+		{
+			const char c = data[i];
+			if (inString)
+			{
+				if (escape)
+				{
+					escape = false;
+				}
+				else if (c == '\\')
+				{
+					escape = true;
+				}
+				else if (c == '"')
+				{
+					inString = false;
+					if (objectRoot && depth == 1 && expectKey)
+					{
+						keyBegin = stringBegin;
+						keyEnd = i + 1;
+					}
+				}
+				continue;
+			}
+			if (isSpace(c))
+			{
+				continue;
+			}
+			if (objectRoot && depth == 1)
+			{
+				if (c == ':')
+				{
+					expectKey = false;
+					valueStarted = false;
+					continue;
+				}
+				if (!expectKey && !valueStarted)
+				{
+					valueStarted = true;
+					valueBegin = i;
+					if (c == '[')
+					{
+						splitting = true;
+						chunkBegin = i + 1;
+					}
+				}
+			}
+			switch (c)
+			{
+			case '"':
+				inString = true;
+				stringBegin = i;
+				break;
+			case '{':
+			case '[':
+				depth++;
+				break;
+			case '}':
+			case ']':
+				depth--;
+				if (splitting && depth == 1)
+				{
+					if (split)
+					{
+						pushPart(split, chunkBegin, i);
+						release(split);
+						split = nullptr;
+						memberSplit = true;
+					}
+					splitting = false;
+				}
+				else if (depth == 0)
+				{
+					if (objectRoot)
+					{
+						endMember(keyBegin, keyEnd, valueStarted ? valueBegin : -1, i, memberSplit, ordinal);
+					}
+					else
+					{
+						pushElements(chunkBegin, i);
+					}
+				}
+				break;
+			case ',':
+				if (depth == 1)
+				{
+					if (objectRoot)
+					{
+						endMember(keyBegin, keyEnd, valueStarted ? valueBegin : -1, i, memberSplit, ordinal);
+						expectKey = true;
+						valueStarted = false;
+						keyBegin = -1;
+						memberSplit = false;
+					}
+					else if (i - chunkBegin >= chunk)
+					{
+						pushElements(chunkBegin, i);
+						chunkBegin = i + 1;
+					}
+				}
+				else if (depth == 2 && splitting && i - chunkBegin >= chunk)
+				{
+					if (!split)
+					{
+						m_splits.emplace_back();
+						split = &m_splits.back();
+						split->keyBegin = keyBegin;
+						split->keyEnd = keyEnd;
+						split->ordinal = ordinal;
+						split->access = fieldAccess(keyBegin, keyEnd);
+					}
+					pushPart(split, chunkBegin, i);
+					chunkBegin = i + 1;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		for (; i < size; i++)
+		{
+			if (!isSpace(data[i]))
+			{
+				m_error.store(true, std::memory_order_relaxed);
+			}
+		}
+		if (depth != 0 || inString)
+		{
+			m_error.store(true, std::memory_order_relaxed);
+			if (split)
+			{
+				release(split);
+			}
+		}
+		flush();
+	}
+
+	void endMember(int keyBegin, int keyEnd, int valueBegin, int end, bool memberSplit, int &ordinal)
+	{
+		if (keyBegin < 0 || valueBegin < 0)
+		{
+			// 空对象 {} 没有成员；其余情况为键或值缺失
+			if (keyBegin >= 0 || valueBegin >= 0 || ordinal > 0)
+			{
+				m_error.store(true, std::memory_order_relaxed);
+			}
+			return;
+		}
+		if (!memberSplit)
+		{
+			push({keyBegin, keyEnd, valueBegin, end, ordinal, nullptr, nullptr, nullptr});
+		}
+		ordinal++;
+	}
+
+	void pushPart(Split *split, int begin, int end)
+	{
+		split->parts.emplace_back();
+		split->pending.fetch_add(1, std::memory_order_relaxed);
+		push({split->keyBegin, split->keyEnd, begin, end, split->ordinal, split, &split->parts.back(), nullptr});
+	}
+
+	void pushElements(int begin, int end)
+	{
+		m_parts.emplace_back();
+		push({-1, -1, begin, end, 0, nullptr, nullptr, &m_parts.back()});
+	}
+
+	void push(const Entry &entry)
+	{
+		m_block.push_back(entry);
+		m_blockBytes += entry.end - entry.begin;
+		if (static_cast<int>(m_block.size()) >= m_options.blockSize || m_blockBytes >= m_options.chunkBytes)
+		{
+			flush();
+		}
+	}
+
+	void flush()
+	{
+		if (m_block.empty())
+		{
+			return;
+		}
+		while (!m_queue.tryPush(m_block))
+		{
+			std::this_thread::yield();
+		}
+		m_block = Block();
+		m_block.reserve(m_options.blockSize);
+		m_blockBytes = 0;
+	}
+
+	/**
+	 * @brief 解码线程：从队列取块并处理，分词结束且队列为空时退出
+	 */
+	void work()
+	{
+		Block block;
+		for (;;)
+		{
+			if (m_queue.tryPop(block))
+			{
+				for (const Entry &entry : block)
+				{
+					process(entry);
+				}
+				continue;
+			}
+			if (m_done.load(std::memory_order_acquire))
+			{
+				// 结束标记之前入队的块此时均可见
+				if (m_queue.tryPop(block))
+				{
+					for (const Entry &entry : block)
+					{
+						process(entry);
+					}
+					continue;
+				}
+				return;
+			}
+			std::this_thread::yield();
+		}
+	}
+
+	void process(const Entry &entry)
+	{
+		if (entry.elements)
+		{
+			QJsonArray array;
+			if (parseArray(entry.begin, entry.end, array))
+			{
+				entry.elements->reserve(array.size());
+				for (const QJsonValue &element : array)
+				{
+					entry.elements->push_back(Serializer<Element>::fromJson(element));
+				}
+			}
+		}
+		else if (entry.split)
+		{
+			SplitPart &part = *entry.part;
+			if (parseArray(entry.begin, entry.end, part.array) && entry.split->access)
+			{
+				// 在解析该段的线程中解码元素，拼接时只需移动
+				part.elements = entry.split->access->decodeElements(part.array);
+				if (part.elements)
+				{
+					part.array = QJsonArray();
+				}
+			}
+			release(entry.split);
+		}
+		else
+		{
+			QJsonValue value;
+			if (parseValue(entry.begin, entry.end, value))
+			{
+				assign(entry.keyBegin, entry.keyEnd, value, entry.ordinal);
+			}
+		}
+	}
+
+	void release(Split *split)
+	{
+		if (split->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		{
+			return;
+		}
+		std::vector<std::shared_ptr<void>> decoded;
+		decoded.reserve(split->parts.size());
+		for (const SplitPart &part : split->parts)
+		{
+			if (!part.elements)
+			{
+				break;
+			}
+			decoded.push_back(part.elements);
+		}
+		if (decoded.size() == split->parts.size())
+		{
+			splice(split, decoded);
+			return;
+		}
+		// 成员没有可用的访问接口，或有一段解析失败（此时已记录错误）
+		QJsonArray array;
+		for (const SplitPart &part : split->parts)
+		{
+			for (const QJsonValue &element : part.array)
+			{
+				array.append(element);
+			}
+		}
+		assign(split->keyBegin, split->keyEnd, array, split->ordinal);
+	}
+
+	/**
+	 * @brief 以各段解码好的元素替换成员；同一属性只保留文档中序号最大的值
+	 */
+	void splice(Split *split, const std::vector<std::shared_ptr<void>> &decoded)
+	{
+		QString key;
+		if (!parseKey(split->keyBegin, split->keyEnd, key))
+		{
+			return;
+		}
+		int index = m_table->indexOf(key, split->ordinal);
+		if (index < 0)
+		{
+			return;
+		}
+		std::lock_guard<std::mutex> locker(m_locks[index]);
+		if (split->ordinal > m_ordinals[index])
+		{
+			m_ordinals[index] = split->ordinal;
+			split->access->spliceElements(&m_value, decoded);
+		}
+	}
+
+	/**
+	 * @brief 取得成员的访问接口，键不对应属性或属性没有访问接口时返回 nullptr
+	 */
+	const JsonFieldAccess *fieldAccess(int keyBegin, int keyEnd)
+	{
+		if constexpr (IsJsonSerializable<T>::value)
+		{
+			QString key;
+			if (!parseKey(keyBegin, keyEnd, key))
+			{
+				return nullptr;
+			}
+			int index = m_table->indexOf(key);
+			return index >= 0 ? m_table->entries().at(index).access : nullptr;
+		}
+		else
+		{
+			Q_UNUSED(keyBegin);
+			Q_UNUSED(keyEnd);
+			return nullptr;
+		}
+	}
+
+	/**
+	 * @brief 写入成员；同一属性只保留文档中序号最大的值
+	 */
+	void assign(int keyBegin, int keyEnd, const QJsonValue &value, int ordinal)
+	{
+		if constexpr (IsJsonSerializable<T>::value)
+		{
+			QString key;
+			if (!parseKey(keyBegin, keyEnd, key))
+			{
+				return;
+			}
+			// ordinal 是成员在文档中的位置，各解码线程以它推测属性
+			int index = m_table->indexOf(key, ordinal);
+			if (index < 0)
+			{
+				return;
+			}
+			std::lock_guard<std::mutex> locker(m_locks[index]);
+			if (ordinal > m_ordinals[index])
+			{
+				m_ordinals[index] = ordinal;
+				m_table->entries().at(index).property.writeOnGadget(&m_value, value);
+			}
+		}
+		else
+		{
+			Q_UNUSED(keyBegin);
+			Q_UNUSED(keyEnd);
+			Q_UNUSED(value);
+			Q_UNUSED(ordinal);
+		}
+	}
+
+	bool parseKey(int begin, int end, QString &key)
+	{
+		const char *data = m_data.constData() + begin;
+		const int size = end - begin;
+		if (std::find(data, data + size, '\\') == data + size)
+		{
+			key = QString::fromUtf8(data + 1, size - 2);
+			return true;
+		}
+		QJsonValue value;
+		if (!parseValue(begin, end, value))
+		{
+			return false;
+		}
+		key = value.toString();
+		return true;
+	}
+
+	/**
+	 * @brief 解析一个值；对象与数组直接引用原始数据，标量包装为单元素数组后解析
+	 */
+	bool parseValue(int begin, int end, QJsonValue &value)
+	{
+		trim(begin, end);
+		const char *data = m_data.constData();
+		QJsonParseError error;
+		if (begin < end && (data[begin] == '{' || data[begin] == '['))
+		{
+			QJsonDocument document = QJsonDocument::fromJson(QByteArray::fromRawData(data + begin, end - begin), &error);
+			if (error.error == QJsonParseError::NoError)
+			{
+				value = document.isArray() ? QJsonValue(document.array()) : QJsonValue(document.object());
+				return true;
+			}
+		}
+		else
+		{
+			QJsonArray array;
+			if (parseArray(begin, end, array) && array.size() == 1)
+			{
+				value = array.at(0);
+				return true;
+			}
+		}
+		m_error.store(true, std::memory_order_relaxed);
+		return false;
+	}
+
+	/**
+	 * @brief 将以逗号分隔的一段元素解析为数组
+	 */
+	bool parseArray(int begin, int end, QJsonArray &array)
+	{
+		trim(begin, end);
+		if (begin == end)
+		{
+			return true;
+		}
+		QByteArray wrapped;
+		wrapped.reserve(end - begin + 2);
+		wrapped.append('[');
+		wrapped.append(m_data.constData() + begin, end - begin);
+		wrapped.append(']');
+		QJsonParseError error;
+		QJsonDocument document = QJsonDocument::fromJson(wrapped, &error);
+		if (error.error != QJsonParseError::NoError)
+		{
+			m_error.store(true, std::memory_order_relaxed);
+			return false;
+		}
+		array = document.array();
+		return true;
+	}
+
+	void trim(int &begin, int &end) const
+	{
+		const char *data = m_data.constData();
+		while (begin < end && isSpace(data[begin]))
+		{
+			begin++;
+		}
+		while (end > begin && isSpace(data[end - 1]))
+		{
+			end--;
+		}
+	}
+
+	/**
+	 * @brief 根为数组时按原顺序拼接各段的解码结果
+	 */
+	void assemble()
+	{
+		std::size_t total = 0;
+		for (const Elements &part : m_parts)
+		{
+			total += part.size();
+		}
+		T result;
+		result.reserve(static_cast<typename T::size_type>(total));
+		for (Elements &part : m_parts)
+		{
+			for (Element &element : part)
+			{
+				result.push_back(std::move(element));
+			}
+		}
+		m_value = std::move(result);
+	}
+
+	const QByteArray &m_data;
+	T &m_value;
+	const JsonPipelineOptions m_options;
+	const JsonPropertyTable *m_table = nullptr;
+	std::unique_ptr<std::mutex[]> m_locks;
+	std::vector<int> m_ordinals;
+	JsonBoundedQueue<Block> m_queue;
+	Block m_block;
+	int m_blockBytes = 0;
+	std::deque<Split> m_splits;
+	std::deque<Elements> m_parts;
+	std::atomic<bool> m_done{false};
+	std::atomic<bool> m_error{false};
+};
+
+#endif // JSON_SERIALIZER_PIPELINE_H
@@ -0,0 +1,172 @@
+// File: JsonSerializerTimeSliced
+// Author: linxmouse@gmail.com
+// Creation: 2024/09/29
+#ifndef JSON_SERIALIZER_TIME_SLICED_H
+#define JSON_SERIALIZER_TIME_SLICED_H
+
+#include "JsonSerializer.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+/**
+ * @brief 分时的协作式编码器
+ * @tparam T 值的类型
+ * @details
+ * 以显式栈保存遍历位置，每次 step() 只做有限的工作（字节数或时间预算），之后可以交还事件循环，
+ * 下次调用从上次停下的位置继续；不创建线程
+ * 可序列化类逐个属性展开，序列容器逐个元素展开，其他值（映射、自定义序列化器的属性等）在一步内整体写出，
+ * 单步的最大耗时取决于最大的此类值
+ * 输出为紧凑 JSON，与 toCompactJson() / JsonWriter::serialize() 相同
+ * 值在构造时按值传入（可 std::move，否则复制为快照），构造时的浮点精度与短键名设置在每一步中保持不变
+ * @code
+ * JsonTimeSlicedEncoder<TestPagedPerson> encoder(pagedPerson);
+ * while (!encoder.step(64 * 1024))
+ * {
+ *     QCoreApplication::processEvents();
+ * }
+ * QByteArray json = encoder.takeResult();
+ * @endcode
+ */
+template <typename T>
+class JsonTimeSlicedEncoder
+{
+public:
+	explicit JsonTimeSlicedEncoder(T value)
+		: m_value(std::move(value)), m_writer(m_buffer), m_precision(JsonFloatPrecision::current()), m_compact(JsonCompactKeysScope::active())
+	{
+		JsonCompactKeysScope keysScope(m_compact);
+		std::unique_ptr<JsonEncodeFrame> root = JsonEncodeFrameOf<T>::create(m_value);
+		if (root)
+		{
+			m_stack.push_back(std::move(root));
+		}
+		else
+		{
+			m_pendingValue = true;
+		}
+	}
+
+	JsonTimeSlicedEncoder(const JsonTimeSlicedEncoder &) = delete;
+	JsonTimeSlicedEncoder &operator=(const JsonTimeSlicedEncoder &) = delete;
+
+	/**
+	 * @brief 执行一段编码
+	 * @param maxBytes 本段最多追加的字节数（在一步写完后检查），小于等于 0 表示不限制
+	 * @param maxMsecs 本段的时间预算（毫秒），小于 0 表示不限制
+	 * @return bool 编码已完成时返回 true
+	 */
+	bool step(int maxBytes, int maxMsecs = -1)
+	{
+		if (isFinished())
+		{
+			return true;
+		}
+		JsonFloatPrecisionScope precisionScope(m_precision);
+		JsonCompactKeysScope keysScope(m_compact);
+		if (m_pendingValue)
+		{
+			m_writer.write(m_value);
+			m_pendingValue = false;
+			return true;
+		}
+
+		QElapsedTimer timer;
+		if (maxMsecs >= 0)
+		{
+			timer.start();
+		}
+		const int limit = maxBytes > 0 ? m_buffer.size() + maxBytes : 0;
+		for (int steps = 1; !m_stack.empty(); steps++)
+		{
+			std::unique_ptr<JsonEncodeFrame> child;
+			if (m_stack.back()->step(m_writer, child))
+			{
+				m_stack.pop_back();
+			}
+			else if (child)
+			{
+				m_stack.push_back(std::move(child));
+			}
+			if (maxBytes > 0 && m_buffer.size() >= limit)
+			{
+				break;
+			}
+			// 计时本身也有开销，每 16 步检查一次
+			if (maxMsecs >= 0 && (steps & 15) == 0 && timer.elapsed() >= maxMsecs)
+			{
+				break;
+			}
+		}
+		return isFinished();
+	}
+
+	bool isFinished() const
+	{
+		return m_stack.empty() && !m_pendingValue;
+	}
+
+	/**
+	 * @brief 已写出的字节数
+	 */
+	int bytesWritten() const
+	{
+		return m_buffer.size();
+	}
+
+	/**
+	 * @brief 取走编码结果；未完成时为已写出的部分
+	 */
+	QByteArray takeResult()
+	{
+		QByteArray result;
+		result.swap(m_buffer);
+		return result;
+	}
+
+private:
+	T m_value;
+	QByteArray m_buffer;
+	JsonWriter m_writer;
+	const JsonFloatPrecision m_precision;
+	const bool m_compact;
+	std::vector<std::unique_ptr<JsonEncodeFrame>> m_stack;
+	bool m_pendingValue = false;
+};
+
+/**
+ * @brief 在事件循环中分时编码
+ */
+struct JsonTimeSliced
+{
+	/**
+	 * @brief 以零间隔定时器驱动编码，每次事件循环迭代最多占用 sliceMsecs 毫秒，完成后调用 function
+	 * @details
+	 * 需在 context 所在线程中调用，定时器以 context 为父对象，context 先于编码完成被销毁时不会调用 function
+	 * @param value 待编码的值（移动或复制为快照）
+	 * @param context 驱动编码并接收结果的对象
+	 * @param sliceMsecs 每段的时间预算（毫秒）
+	 * @param function 以紧凑 JSON 字节数据为参数的回调
+	 * @return QTimer* 驱动编码的定时器，可以 stop() 或 deleteLater() 取消
+	 */
+	template <typename T, typename Function>
+	static QTimer *toCompactJson(T value, QObject *context, int sliceMsecs, Function function)
+	{
+		auto encoder = std::make_shared<JsonTimeSlicedEncoder<T>>(std::move(value));
+		auto *timer = new QTimer(context);
+		timer->setInterval(0);
+		QObject::connect(timer, &QTimer::timeout, context, [timer, encoder, sliceMsecs, function]() {
+			if (encoder->step(0, sliceMsecs))
+			{
+				timer->stop();
+				timer->deleteLater();
+				function(encoder->takeResult());
+			}
+		});
+		timer->start();
+		return timer;
+	}
+};
+
+#endif // JSON_SERIALIZER_TIME_SLICED_H
@@ -0,0 +1,21 @@
+// File: TestGeneratedOrder
+// Author: linxmouse@gmail.com
+// Creation: 2024/09/29
+#ifndef TEST_GENERATED_ORDER_H
+#define TEST_GENERATED_ORDER_H
+
+#include "JsonSerializer.h"
+
+/**
+ * @brief 由 JsonSerializerGen 生成序列化代码的测试类
+ */
+class TestGeneratedOrder final : public JsonSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY_ALIAS(QString, orderId, id)
+	JSON_PROPERTY(int, quantity)
+	JSON_PROPERTY(QList<QString>, tags)
+};
+#endif // !TEST_GENERATED_ORDER_H
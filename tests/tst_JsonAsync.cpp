@@ -0,0 +1,86 @@
+// File: tst_JsonAsync
+// Author: linxmouse@gmail.com
+// Creation: 2024/09/29
+#include <QtTest>
+#include <QException>
+#include <QFutureInterface>
+#include "JsonSerializerAsync.h"
+#include "TestPerson.h"
+
+static TestPerson makePerson()
+{
+	TestPerson person;
+	person.set_name(QStringLiteral("Ada"));
+	person.set_age(36);
+	person.set_hobbies({QStringLiteral("math"), QStringLiteral("chess")});
+	return person;
+}
+
+class TestJsonAsync : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void encodeDecode();
+	void thenDeliversResult();
+	void thenSkipsCanceled();
+	void thenSkipsException();
+};
+
+void TestJsonAsync::encodeDecode()
+{
+	const TestPerson person = makePerson();
+	QFuture<QByteArray> encoded = JsonAsync::toRawJsonAsync(person);
+	QCOMPARE(encoded.result(), person.toRawJson());
+
+	QFuture<TestPerson> decoded = JsonAsync::fromJsonAsync<TestPerson>(encoded.result());
+	QCOMPARE(decoded.result().toRawJson(), person.toRawJson());
+}
+
+void TestJsonAsync::thenDeliversResult()
+{
+	const TestPerson person = makePerson();
+	QObject context;
+	QByteArray received;
+	bool canceled = false;
+	JsonAsync::then(JsonAsync::toRawJsonAsync(person), &context, [&received](const QByteArray &json) { received = json; }, [&canceled]() { canceled = true; });
+	QTRY_COMPARE(received, person.toRawJson());
+	QVERIFY(!canceled);
+}
+
+void TestJsonAsync::thenSkipsCanceled()
+{
+	QFutureInterface<QByteArray> interface;
+	interface.reportStarted();
+	interface.cancel();
+	interface.reportFinished();
+
+	QObject context;
+	bool called = false;
+	bool canceled = false;
+	// 不带 canceled 的重载同样不能以无效结果调用回调
+	JsonAsync::then(interface.future(), &context, [&called](const QByteArray &) { called = true; });
+	JsonAsync::then(interface.future(), &context, [&called](const QByteArray &) { called = true; }, [&canceled]() { canceled = true; });
+	QTRY_VERIFY(canceled);
+	QCoreApplication::processEvents();
+	QVERIFY(!called);
+}
+
+void TestJsonAsync::thenSkipsException()
+{
+	QFutureInterface<QByteArray> interface;
+	interface.reportStarted();
+	interface.reportException(QUnhandledException());
+	interface.reportFinished();
+
+	QObject context;
+	bool called = false;
+	bool canceled = false;
+	JsonAsync::then(interface.future(), &context, [&called](const QByteArray &) { called = true; }, [&canceled]() { canceled = true; });
+	QTRY_VERIFY(canceled);
+	QVERIFY(!called);
+}
+
+QTEST_GUILESS_MAIN(TestJsonAsync)
+
+#include "tst_JsonAsync.moc"
@@ -0,0 +1,117 @@
+// File: tst_JsonCoroutine
+// Author: linxmouse@gmail.com
+// Creation: 2024/09/29
+#include <QtTest>
+#include "JsonSerializerIncremental.h"
+#include "TestPagedPerson.h"
+
+#ifndef JSON_SERIALIZER_HAS_COROUTINES
+#error "tst_JsonCoroutine requires C++20 coroutines"
+#endif
+
+static TestPagedPerson makePaged(int count)
+{
+	TestPageInfo page;
+	page.set_totalNumber(count);
+	page.set_totalPage(1);
+	page.set_pageSize(count);
+	page.set_currentPage(1);
+	std::vector<TestPerson> persons;
+	for (int i = 0; i < count; i++)
+	{
+		TestPerson person;
+		person.set_name(QStringLiteral("P%1").arg(i));
+		person.set_age(20 + i);
+		person.set_hobbies({QStringLiteral("a,}\"]")});
+		persons.push_back(person);
+	}
+	TestPagedPerson paged;
+	paged.set_page(page);
+	paged.set_persons(std::move(persons));
+	return paged;
+}
+
+class TestJsonCoroutine : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void decodeObject();
+	void decodeScalar();
+	void decodeErrors();
+	void destroyWhileSuspended();
+};
+
+void TestJsonCoroutine::decodeObject()
+{
+	const TestPagedPerson paged = makePaged(20);
+	const QByteArray data = paged.toRawJson();
+	JsonChunkChannel channel;
+	JsonDecodeTask<TestPagedPerson> task = JsonCoroutine::decode<TestPagedPerson>(channel);
+	for (int i = 0; i < data.size(); i += 16)
+	{
+		QVERIFY(!task.isReady());
+		channel.push(data.mid(i, 16));
+	}
+	// 根值读完即结束，不需要关闭通道
+	QVERIFY(task.isReady());
+	QVERIFY(task.result().has_value());
+	QCOMPARE(task.result()->toCompactJson(), paged.toCompactJson());
+}
+
+void TestJsonCoroutine::decodeScalar()
+{
+	JsonChunkChannel channel;
+	JsonDecodeTask<int> task = JsonCoroutine::decode<int>(channel);
+	channel.push(QByteArray("4"));
+	channel.push(QByteArray("2"));
+	// 标量根只有在输入结束时才能确定已经读完
+	QVERIFY(!task.isReady());
+	channel.close();
+	QVERIFY(task.isReady());
+	QCOMPARE(task.result(), std::optional<int>(42));
+}
+
+void TestJsonCoroutine::decodeErrors()
+{
+	const QByteArray data = makePaged(5).toCompactJson();
+	JsonChunkChannel truncated;
+	JsonDecodeTask<TestPagedPerson> object = JsonCoroutine::decode<TestPagedPerson>(truncated);
+	truncated.push(data.left(data.size() - 1));
+	truncated.close();
+	QVERIFY(object.isReady());
+	QVERIFY(!object.result().has_value());
+
+	JsonChunkChannel trailing;
+	JsonDecodeTask<int> scalar = JsonCoroutine::decode<int>(trailing);
+	trailing.push(QByteArray("1,2"));
+	trailing.close();
+	QVERIFY(scalar.isReady());
+	QVERIFY(!scalar.result().has_value());
+}
+
+void TestJsonCoroutine::destroyWhileSuspended()
+{
+	JsonChunkChannel channel;
+	{
+		JsonDecodeTask<TestPagedPerson> task = JsonCoroutine::decode<TestPagedPerson>(channel);
+		channel.push(QByteArray("{\"page\":"));
+		QVERIFY(!task.isReady());
+	}
+	// 任务析构时撤销了等待，之后的输入不会恢复已经销毁的协程帧
+	channel.push(QByteArray("{}}"));
+	channel.close();
+
+	// 新任务先开始等待同一个通道，移动赋值再销毁原任务，撤销时不能清除新任务的等待
+	JsonChunkChannel next;
+	JsonDecodeTask<int> scalar = JsonCoroutine::decode<int>(next);
+	scalar = JsonCoroutine::decode<int>(next);
+	next.push(QByteArray("7"));
+	next.close();
+	QVERIFY(scalar.isReady());
+	QCOMPARE(scalar.result(), std::optional<int>(7));
+}
+
+QTEST_GUILESS_MAIN(TestJsonCoroutine)
+
+#include "tst_JsonCoroutine.moc"
@@ -0,0 +1,1176 @@
+// File: tst_JsonSerializer
+// Author: linxmouse@gmail.com
+// Creation: 2024/09/29
+#include <QtTest>
+#include <thread>
+#include "JsonSerializer.h"
+#include "JsonSerializerDecodeCache.h"
+#include "JsonSerializerFingerprint.h"
+#include "TestGeneratedOrder.h"
+#include "TestPagedPerson.h"
+
+/**
+ * @brief 静态分派的可序列化类
+ */
+class TestPoint final : public JsonSerializableT<TestPoint>
+{
+	Q_GADGET
+public:
+	JSON_PROPERTY(int, x)
+	JSON_PROPERTY(int, y)
+	JSON_PROPERTY(QList<QString>, labels)
+};
+
+static_assert(!std::is_polymorphic<TestPoint>::value, "JsonSerializableT must not add a vtable");
+static_assert(IsJsonSerializable<TestPoint>::value, "JsonSerializableT classes are serializable");
+
+/**
+ * @brief 纳秒时长在 JSON 中按微秒计数
+ */
+template <>
+struct JsonChronoUnit<std::chrono::nanoseconds>
+{
+	using type = std::chrono::microseconds;
+};
+
+/**
+ * @brief 时长与时间点成员
+ */
+class TestSchedule final : public JsonSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY(std::chrono::milliseconds, timeout)
+	JSON_PROPERTY(std::chrono::nanoseconds, latency)
+	JSON_PROPERTY(std::chrono::system_clock::time_point, createdAt)
+};
+
+/**
+ * @brief 被共享引用的对象
+ */
+class TestNode : public JsonSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY(QString, name)
+};
+
+/**
+ * @brief 声明顺序与键序相反的共享引用：b 先输出并附带 "$id"，键序靠前的 a 输出为 "$ref"
+ */
+class TestGraph final : public JsonSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY(std::shared_ptr<TestNode>, b)
+	JSON_PROPERTY(std::shared_ptr<TestNode>, a)
+	JSON_PROPERTY(std::shared_ptr<QString>, note)
+	JSON_PROPERTY(std::shared_ptr<QString>, remark)
+};
+
+/**
+ * @brief 多态层次的基类
+ */
+class TestShape : public JsonSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY(QString, label)
+};
+
+class TestCircle final : public TestShape
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY(double, radius)
+};
+
+class TestSquare final : public TestShape
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY(int, side)
+};
+
+JSON_REGISTER_TYPE(TestShape, TestCircle)
+JSON_REGISTER_TYPE(TestShape, TestSquare)
+
+/**
+ * @brief 经由基类指针持有的多态成员，键序靠前的 first 输出为 "$ref"
+ */
+class TestDrawing final : public JsonSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY(std::shared_ptr<TestShape>, second)
+	JSON_PROPERTY(std::shared_ptr<TestShape>, first)
+	JSON_PROPERTY(std::vector<std::shared_ptr<TestShape>>, shapes)
+};
+
+/**
+ * @brief 按属性固定精度的浮点数
+ */
+class TestMeasurement final : public JsonSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY_DECIMALS(double, price, 2)
+	JSON_PROPERTY_SIGNIFICANT(QList<double>, readings, 3)
+	JSON_PROPERTY(double, raw)
+};
+
+/**
+ * @brief 列式编码
+ */
+class TestRoster final : public JsonSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY_COLUMNAR(QList<TestPerson>, members)
+};
+
+/**
+ * @brief 显式短键名
+ */
+class TestAliased final : public JsonSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY_ALIAS(QString, identifier, id)
+	JSON_PROPERTY(int, count)
+	JSON_PROPERTY(QString, label)
+};
+
+/**
+ * @brief 显式短键名与另一个属性的完整键名相同
+ */
+class TestAliasCollision final : public JsonSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY_ALIAS(int, first, second)
+	JSON_PROPERTY(int, second)
+};
+
+/**
+ * @brief 差分编码
+ */
+class TestSeries final : public JsonSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY_DELTA(std::vector<qint64>, stamps)
+	JSON_PROPERTY_WITH(QVector<int>, offsets, JsonDeltaSerializer<QVector<int>, true>)
+};
+
+using TestCounts = QMap<QString, int>;
+
+/**
+ * @brief 映射与 std::vector<bool> 成员
+ */
+class TestInventory final : public JsonSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY(QString, owner)
+	JSON_PROPERTY(TestCounts, counts)
+	JSON_PROPERTY(std::vector<bool>, flags)
+};
+
+/**
+ * @brief 可以缓存的对象
+ */
+class TestCachedLeaf final : public JsonCachedSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY(QString, title)
+	JSON_PROPERTY(int, rank)
+};
+
+/**
+ * @brief 经由共享指针持有成员、不使用缓存的对象
+ */
+class TestCachedHolder final : public JsonCachedSerializable
+{
+	Q_GADGET
+	JSON_SERIALIZABLE
+public:
+	JSON_PROPERTY(std::vector<std::shared_ptr<TestCachedLeaf>>, leaves)
+};
+
+enum class TestColor : qint16
+{
+	Red = 1,
+	Blue = -2
+};
+
+/**
+ * @brief 无 Q_GADGET 的普通结构体
+ */
+struct TestSample
+{
+	QString name;
+	int value = 0;
+	double ratio = 0;
+	std::vector<int> series;
+};
+JSON_FIELDS(TestSample, name, value, ratio, series)
+
+using TestLabels = QMap<int, QString>;
+using TestIntMap = QMap<int, int>;
+using TestIntHash = QHash<int, int>;
+using TestStdIntMap = std::map<int, int>;
+
+static QByteArray compact(const QJsonObject &json)
+{
+	return QJsonDocument(json).toJson(QJsonDocument::Compact);
+}
+
+static TestPerson makePerson(const QString &name, int age, const QList<QString> &hobbies)
+{
+	TestPerson person;
+	person.set_name(name);
+	person.set_age(age);
+	person.set_hobbies(hobbies);
+	return person;
+}
+
+static TestPagedPerson makePaged(int count)
+{
+	TestPageInfo page;
+	page.set_totalNumber(count);
+	page.set_totalPage(1);
+	page.set_pageSize(count);
+	page.set_currentPage(1);
+	std::vector<TestPerson> persons;
+	for (int i = 0; i < count; i++)
+	{
+		persons.push_back(makePerson(QStringLiteral("P%1").arg(i), 20 + i % 50, {QStringLiteral("reading")}));
+	}
+	TestPagedPerson paged;
+	paged.set_page(page);
+	paged.set_persons(std::move(persons));
+	return paged;
+}
+
+static TestSample makeSample()
+{
+	TestSample sample;
+	sample.name = QStringLiteral("s");
+	sample.value = 7;
+	sample.ratio = 0.5;
+	sample.series = {1, 2, 3};
+	return sample;
+}
+
+class TestJsonSerializer : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void staticSerializable();
+	void chronoTypes();
+	void sharedPointers();
+	void sharedPointerTypeMismatch();
+	void polymorphicPointers();
+	void numbers();
+	void floatPrecision();
+	void mapKeys();
+	void invalidMapKeys();
+	void columnarEncoding();
+	void aliasKeys();
+	void compactKeys();
+	void aliasCollision();
+	void deltaEncoding();
+	void jsonFields();
+	void generatedCodec();
+	void fieldAccessors();
+	void cachedSerializable();
+	void cachedSerializableThreads();
+	void cachedSerializableReferenceScope();
+	void cachedSerializableSharedMembers();
+	void mergePatchDiff();
+	void mergePatchApply();
+	void fingerprintVectors();
+	void fingerprintCanonical();
+	void overwriteDecode();
+	void decodeCache();
+	void keyOrderSpeculation();
+};
+
+void TestJsonSerializer::staticSerializable()
+{
+	TestPoint point{};
+	point.set_x(1);
+	point.set_y(-2);
+	point.set_labels({QStringLiteral("p")});
+	const QByteArray expected("{\"labels\":[\"p\"],\"x\":1,\"y\":-2}");
+	QCOMPARE(point.toCompactJson(), expected);
+	QCOMPARE(compact(point.toJson()), expected);
+	QCOMPARE(QByteArray(point.jsonTypeName()), QByteArray("TestPoint"));
+
+	TestPoint decoded{};
+	decoded.fromJson(point.toRawJson());
+	QCOMPARE(decoded.toCompactJson(), expected);
+
+	// 作为容器元素与 JsonWriter 的成员时走同一个属性表
+	const std::vector<TestPoint> points{point, point};
+	const QByteArray array = JsonWriter::serialize(points);
+	QCOMPARE(array, "[" + expected + "," + expected + "]");
+	const std::vector<TestPoint> restored = Serializer<std::vector<TestPoint>>::fromJson(Serializer<std::vector<TestPoint>>::toJson(points));
+	QVERIFY(restored.size() == 2);
+	QCOMPARE(restored.at(1).toCompactJson(), expected);
+
+	TestPoint patched = point;
+	patched.applyJsonPatch(point.diffJson(decoded));
+	QVERIFY(point.diffJson(patched).isEmpty());
+	patched.overwriteFromJson(QByteArray("{\"x\":5}"));
+	QCOMPARE(patched.toCompactJson(), QByteArray("{\"labels\":[],\"x\":5,\"y\":0}"));
+}
+
+void TestJsonSerializer::chronoTypes()
+{
+	using namespace std::chrono;
+	TestSchedule schedule;
+	schedule.set_timeout(milliseconds(-1500));
+	schedule.set_latency(nanoseconds(2500000));
+	schedule.set_createdAt(system_clock::time_point(milliseconds(Q_INT64_C(1700000000123))));
+
+	// 时长按自身单位计数，纳秒按特化的微秒计数，时间点按距纪元的毫秒数计数
+	const QByteArray expected("{\"createdAt\":1700000000123,\"latency\":2500,\"timeout\":-1500}");
+	QCOMPARE(schedule.toCompactJson(), expected);
+	QCOMPARE(compact(schedule.toJson()), expected);
+
+	TestSchedule decoded;
+	decoded.fromJson(expected);
+	QVERIFY(decoded.timeout() == schedule.timeout());
+	QVERIFY(decoded.latency() == schedule.latency());
+	QVERIFY(decoded.createdAt() == schedule.createdAt());
+
+	QCOMPARE(Serializer<seconds>::toJson(seconds(42)).toInt(), 42);
+	QVERIFY(Serializer<seconds>::fromJson(QJsonValue(7)) == seconds(7));
+	QVERIFY(Serializer<std::vector<minutes>>::fromJson(QJsonArray({1, 2})) == std::vector<minutes>({minutes(1), minutes(2)}));
+}
+
+void TestJsonSerializer::sharedPointers()
+{
+	auto node = std::make_shared<TestNode>();
+	node->set_name(QStringLiteral("n"));
+	auto text = std::make_shared<QString>(QStringLiteral("t"));
+	TestGraph graph;
+	graph.set_b(node);
+	graph.set_a(node);
+	graph.set_note(text);
+	graph.set_remark(text);
+
+	// 作用域之外按值输出
+	QCOMPARE(graph.toCompactJson(), QByteArray("{\"a\":{\"name\":\"n\"},\"b\":{\"name\":\"n\"},\"note\":\"t\",\"remark\":\"t\"}"));
+
+	QJsonObject json;
+	{
+		JsonReferenceScope scope;
+		json = graph.toJson();
+	}
+	// 字符串无法附带 "$id"，两处都按值输出，不产生无法解析的 "$ref"
+	QCOMPARE(compact(json), QByteArray("{\"a\":{\"$ref\":1},\"b\":{\"$id\":1,\"name\":\"n\"},\"note\":\"t\",\"remark\":\"t\"}"));
+
+	// 解码时键序靠前的 "$ref" 先于 "$id" 读到，仍然还原为同一个对象
+	TestGraph decoded;
+	{
+		JsonReferenceScope scope;
+		decoded.fromJson(json);
+	}
+	QVERIFY(decoded.a());
+	QVERIFY(decoded.a() == decoded.b());
+	QCOMPARE(decoded.a()->name(), QStringLiteral("n"));
+	QVERIFY(decoded.note() && decoded.remark());
+	QCOMPARE(*decoded.note(), QStringLiteral("t"));
+
+	// 写入器按键序输出，a 附带 "$id"
+	QByteArray written;
+	{
+		JsonReferenceScope scope;
+		written = graph.toCompactJson();
+	}
+	QCOMPARE(written, QByteArray("{\"a\":{\"$id\":1,\"name\":\"n\"},\"b\":{\"$ref\":1},\"note\":\"t\",\"remark\":\"t\"}"));
+	TestGraph rewritten;
+	{
+		JsonReferenceScope scope;
+		rewritten.fromJson(written);
+	}
+	QVERIFY(rewritten.a() && rewritten.a() == rewritten.b());
+
+	// 容器中的共享指针
+	const std::vector<std::shared_ptr<TestNode>> nodes{node, nullptr, node};
+	QJsonValue array;
+	{
+		JsonReferenceScope scope;
+		array = Serializer<std::vector<std::shared_ptr<TestNode>>>::toJson(nodes);
+	}
+	std::vector<std::shared_ptr<TestNode>> restored;
+	{
+		JsonReferenceScope scope;
+		restored = Serializer<std::vector<std::shared_ptr<TestNode>>>::fromJson(array);
+	}
+	QVERIFY(restored.size() == 3);
+	QVERIFY(restored.at(0) && restored.at(0) == restored.at(2));
+	QVERIFY(!restored.at(1));
+}
+
+void TestJsonSerializer::sharedPointerTypeMismatch()
+{
+	JsonReferenceScope scope;
+	std::shared_ptr<TestNode> node = Serializer<std::shared_ptr<TestNode>>::fromJson(QJsonObject{{QStringLiteral("$id"), 1}, {QStringLiteral("name"), QStringLiteral("x")}});
+	QVERIFY(node);
+	QCOMPARE(node->name(), QStringLiteral("x"));
+
+	// 同一 id 以另一种指针类型解析时返回空指针
+	const QJsonObject ref{{QStringLiteral("$ref"), 1}};
+	QVERIFY(Serializer<std::shared_ptr<TestNode>>::fromJson(ref) == node);
+	QVERIFY(!Serializer<QSharedPointer<TestNode>>::fromJson(ref));
+	QVERIFY(!Serializer<std::shared_ptr<QString>>::fromJson(ref));
+}
+
+void TestJsonSerializer::polymorphicPointers()
+{
+	auto circle = std::make_shared<TestCircle>();
+	circle->set_label(QStringLiteral("c"));
+	circle->set_radius(1.5);
+	auto square = std::make_shared<TestSquare>();
+	square->set_label(QStringLiteral("s"));
+	square->set_side(2);
+	TestDrawing drawing;
+	drawing.set_shapes({circle, square});
+
+	// 按实际类型输出并附带 "$type"，解码时直接创建对应的派生类
+	const QJsonObject json = drawing.toJson();
+	const QJsonArray shapes = json.value(QStringLiteral("shapes")).toArray();
+	QCOMPARE(compact(shapes.at(0).toObject()), QByteArray("{\"$type\":\"TestCircle\",\"label\":\"c\",\"radius\":1.5}"));
+	QCOMPARE(compact(shapes.at(1).toObject()), QByteArray("{\"$type\":\"TestSquare\",\"label\":\"s\",\"side\":2}"));
+	TestDrawing decoded;
+	decoded.fromJson(json);
+	QVERIFY(decoded.ref_shapes().size() == 2);
+	auto decodedCircle = std::dynamic_pointer_cast<TestCircle>(decoded.ref_shapes().at(0));
+	auto decodedSquare = std::dynamic_pointer_cast<TestSquare>(decoded.ref_shapes().at(1));
+	QVERIFY(decodedCircle && decodedSquare);
+	QCOMPARE(decodedCircle->radius(), 1.5);
+	QCOMPARE(decodedSquare->side(), 2);
+	QCOMPARE(decoded.toCompactJson(), drawing.toCompactJson());
+
+	// 未注册的类名与缺少 "$type" 时按基类创建
+	TestDrawing fallback;
+	fallback.fromJson(QByteArray("{\"shapes\":[{\"$type\":\"TestHexagon\",\"label\":\"h\"},{\"label\":\"p\"}]}"));
+	QVERIFY(fallback.ref_shapes().size() == 2);
+	QCOMPARE(QByteArray(fallback.ref_shapes().at(0)->jsonTypeName()), QByteArray("TestShape"));
+	QCOMPARE(fallback.ref_shapes().at(1)->label(), QStringLiteral("p"));
+
+	// 引用先于定义读到时，按 "$ref" 附带的 "$type" 创建占位对象
+	drawing.set_second(square);
+	drawing.set_first(square);
+	QJsonObject referenced;
+	{
+		JsonReferenceScope scope;
+		referenced = drawing.toJson();
+	}
+	QCOMPARE(compact(referenced.value(QStringLiteral("first")).toObject()), QByteArray("{\"$ref\":1,\"$type\":\"TestSquare\"}"));
+	TestDrawing restored;
+	{
+		JsonReferenceScope scope;
+		restored.fromJson(referenced);
+	}
+	QVERIFY(restored.first() && restored.first() == restored.second());
+	QVERIFY(std::dynamic_pointer_cast<TestSquare>(restored.first()));
+	QCOMPARE(std::static_pointer_cast<TestSquare>(restored.first())->side(), 2);
+	QVERIFY(restored.ref_shapes().at(1) == restored.first());
+}
+
+void TestJsonSerializer::numbers()
+{
+	// 小数四舍五入，超出范围的值收束到取值范围的边界
+	QCOMPARE(Serializer<int>::fromJson(QJsonValue(1.6)), 2);
+	QCOMPARE(Serializer<int>::fromJson(QJsonValue(-1.6)), -2);
+	QCOMPARE(Serializer<int>::fromJson(QJsonValue(1e10)), std::numeric_limits<int>::max());
+	QCOMPARE(Serializer<qint8>::fromJson(QJsonValue(-300)), qint8(-128));
+	QCOMPARE(Serializer<quint8>::fromJson(QJsonValue(-5)), quint8(0));
+	QCOMPARE(Serializer<quint64>::fromJson(QJsonValue(1e30)), std::numeric_limits<quint64>::max());
+	QCOMPARE(Serializer<int>::fromJson(QJsonValue(QStringLiteral("18"))), 18);
+	QCOMPARE(Serializer<bool>::fromJson(QJsonValue(true)), true);
+	QCOMPARE(Serializer<float>::fromJson(QJsonValue(0.5)), 0.5f);
+
+	const QJsonArray mixed{1, 2.6, QStringLiteral("3")};
+	QCOMPARE(Serializer<QList<int>>::fromJson(mixed), QList<int>({1, 3, 3}));
+	QVERIFY(Serializer<std::vector<qint64>>::fromJson(mixed) == std::vector<qint64>({1, 3, 3}));
+
+	// 不超过 qint64 最大值的 quint64 按整数输出，更大的值只能以 double 输出
+	const quint64 large = Q_UINT64_C(1) << 60;
+	QCOMPARE(JsonWriter::serialize(std::numeric_limits<quint64>::max()), JsonWriter::serialize(std::pow(2.0, 64)));
+	QCOMPARE(Serializer<quint64>::toJson(std::numeric_limits<quint64>::max()).toDouble(), std::pow(2.0, 64));
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+	QCOMPARE(JsonWriter::serialize(large), QByteArray("1152921504606846976"));
+	QCOMPARE(Serializer<quint64>::toJson(large).toInteger(), qint64(large));
+	QCOMPARE(Serializer<quint64>::fromJson(Serializer<quint64>::toJson(large + 1)), large + 1);
+#else
+	QCOMPARE(JsonWriter::serialize(large), JsonWriter::serialize(static_cast<double>(large)));
+	QCOMPARE(Serializer<quint64>::fromJson(Serializer<quint64>::toJson(large)), large);
+#endif
+	QCOMPARE(JsonWriter::serialize(quint64(42)), QByteArray("42"));
+	QCOMPARE(Serializer<quint64>::toJson(quint64(42)).toInt(), 42);
+}
+
+void TestJsonSerializer::floatPrecision()
+{
+	QCOMPARE(JsonFloatPrecision::decimals(2).apply(3.14159), 3.14);
+	QCOMPARE(JsonFloatPrecision::decimals(0).apply(-2.5), -3.0);
+	QCOMPARE(JsonFloatPrecision::decimals(-2).apply(12345.0), 12300.0);
+	QCOMPARE(JsonFloatPrecision::significantDigits(3).apply(123456.0), 123000.0);
+	QCOMPARE(JsonFloatPrecision::significantDigits(3).apply(0.000123456), 0.000123);
+	QCOMPARE(JsonFloatPrecision::full().apply(0.1 + 0.2), 0.1 + 0.2);
+	QVERIFY(std::isnan(JsonFloatPrecision::decimals(2).apply(std::nan(""))));
+	// 缩放后超出 2^53 的值原样返回
+	QCOMPARE(JsonFloatPrecision::decimals(10).apply(1e10 + 0.5), 1e10 + 0.5);
+	QVERIFY(JsonFloatPrecision::decimals(2) == JsonFloatPrecision(JsonFloatPrecision::Decimals, 2));
+	QVERIFY(JsonFloatPrecision::full() == JsonFloatPrecision(JsonFloatPrecision::Full, 5));
+
+	TestMeasurement measurement;
+	measurement.set_price(9.8765);
+	measurement.set_readings({1234.5, 0.0012345});
+	measurement.set_raw(1.23456);
+	const QByteArray expected("{\"price\":9.88,\"raw\":1.23456,\"readings\":[1230,0.00123]}");
+	QCOMPARE(measurement.toCompactJson(), expected);
+	QCOMPARE(compact(measurement.toJson()), expected);
+
+	// 作用域只影响没有固定精度的属性，并且可以嵌套
+	{
+		JsonFloatPrecisionScope outer(JsonFloatPrecision::decimals(1));
+		{
+			JsonFloatPrecisionScope inner(JsonFloatPrecision::significantDigits(2));
+			QCOMPARE(JsonFloatPrecision::current(), JsonFloatPrecision::significantDigits(2));
+			QCOMPARE(measurement.toCompactJson(), QByteArray("{\"price\":9.88,\"raw\":1.2,\"readings\":[1230,0.00123]}"));
+		}
+		QCOMPARE(JsonFloatPrecision::current(), JsonFloatPrecision::decimals(1));
+		QCOMPARE(compact(measurement.toJson()), QByteArray("{\"price\":9.88,\"raw\":1.2,\"readings\":[1230,0.00123]}"));
+	}
+	QCOMPARE(JsonFloatPrecision::current(), JsonFloatPrecision::full());
+
+	JsonFloatPrecision::setGlobal(JsonFloatPrecision::decimals(3));
+	QCOMPARE(JsonWriter::serialize(1.23456), QByteArray("1.235"));
+	JsonFloatPrecision::setGlobal(JsonFloatPrecision::full());
+	QCOMPARE(JsonWriter::serialize(1.23456), QByteArray("1.23456"));
+
+	// 解码不受精度策略影响
+	TestMeasurement decoded;
+	decoded.fromJson(QByteArray("{\"price\":1.23456,\"readings\":[],\"raw\":0}"));
+	QCOMPARE(decoded.price(), 1.23456);
+}
+
+void TestJsonSerializer::mapKeys()
+{
+	QCOMPARE(KeyCodec<int>::toKey(std::numeric_limits<int>::min()), QStringLiteral("-2147483648"));
+	QCOMPARE(KeyCodec<quint64>::toKey(std::numeric_limits<quint64>::max()), QStringLiteral("18446744073709551615"));
+	QCOMPARE(KeyCodec<TestColor>::toKey(TestColor::Blue), QStringLiteral("-2"));
+
+	int number = 7;
+	QVERIFY(KeyCodec<int>::fromKey(QStringLiteral("-2147483648"), number));
+	QCOMPARE(number, std::numeric_limits<int>::min());
+	QVERIFY(KeyCodec<int>::fromKey(QStringLiteral("42"), number));
+	QCOMPARE(number, 42);
+	qint64 wide = 0;
+	QVERIFY(KeyCodec<qint64>::fromKey(QStringLiteral("-9223372036854775808"), wide));
+	QCOMPARE(wide, std::numeric_limits<qint64>::min());
+	quint8 small = 1;
+	QVERIFY(KeyCodec<quint8>::fromKey(QStringLiteral("-0"), small));
+	QCOMPARE(small, quint8(0));
+	TestColor color = TestColor::Red;
+	QVERIFY(KeyCodec<TestColor>::fromKey(QStringLiteral("-2"), color));
+	QVERIFY(color == TestColor::Blue);
+	double real = 0;
+	QVERIFY(KeyCodec<double>::fromKey(QStringLiteral("1.5"), real));
+	QCOMPARE(real, 1.5);
+	const QUuid uuid = QUuid::createUuid();
+	QUuid parsed;
+	QVERIFY(KeyCodec<QUuid>::fromKey(KeyCodec<QUuid>::toKey(uuid), parsed));
+	QCOMPARE(parsed, uuid);
+	QVERIFY(KeyCodec<QUuid>::fromKey(KeyCodec<QUuid>::toKey(QUuid()), parsed));
+	QVERIFY(parsed.isNull());
+
+	const TestLabels map{{-1, QStringLiteral("a")}, {20, QStringLiteral("b")}};
+	QCOMPARE(compact(Serializer<TestLabels>::toJson(map).toObject()), QByteArray("{\"-1\":\"a\",\"20\":\"b\"}"));
+	QCOMPARE(Serializer<TestLabels>::fromJson(Serializer<TestLabels>::toJson(map)), map);
+}
+
+void TestJsonSerializer::invalidMapKeys()
+{
+	// 无法解析、为空或超出取值范围的键解析失败，结果不变
+	int number = 7;
+	QVERIFY(!KeyCodec<int>::fromKey(QStringLiteral("abc"), number));
+	QVERIFY(!KeyCodec<int>::fromKey(QString(), number));
+	QVERIFY(!KeyCodec<int>::fromKey(QStringLiteral("-"), number));
+	QVERIFY(!KeyCodec<int>::fromKey(QStringLiteral("2147483648"), number));
+	QVERIFY(!KeyCodec<int>::fromKey(QStringLiteral("-2147483649"), number));
+	QCOMPARE(number, 7);
+	quint8 small = 1;
+	QVERIFY(!KeyCodec<quint8>::fromKey(QStringLiteral("256"), small));
+	QVERIFY(!KeyCodec<quint8>::fromKey(QStringLiteral("-1"), small));
+	QCOMPARE(small, quint8(1));
+	TestColor color = TestColor::Red;
+	QVERIFY(!KeyCodec<TestColor>::fromKey(QStringLiteral("40000"), color));
+	QVERIFY(color == TestColor::Red);
+	double real = 0;
+	QVERIFY(!KeyCodec<double>::fromKey(QStringLiteral("x"), real));
+	QUuid uuid;
+	QVERIFY(!KeyCodec<QUuid>::fromKey(QStringLiteral("not-a-uuid"), uuid));
+
+	// 无效键不会还原为 0 并覆盖真正的键 "0"
+	const QJsonObject json{{QStringLiteral("abc"), 1}, {QStringLiteral("0"), 2}, {QStringLiteral("99999999999"), 3}};
+	const TestIntMap expected{{0, 2}};
+	QCOMPARE(Serializer<TestIntMap>::fromJson(json), expected);
+	QCOMPARE(Serializer<TestIntHash>::fromJson(json).size(), 1);
+	QCOMPARE(Serializer<TestIntHash>::fromJson(json).value(0), 2);
+	QVERIFY(Serializer<TestStdIntMap>::fromJson(json) == TestStdIntMap({{0, 2}}));
+
+	TestIntMap assigned{{0, 5}, {1, 6}};
+	JsonAssign<TestIntMap>::assign(assigned, json);
+	QCOMPARE(assigned, expected);
+	TestStdIntMap assignedStd{{1, 6}};
+	JsonAssign<TestStdIntMap>::assign(assignedStd, json);
+	QVERIFY(assignedStd == TestStdIntMap({{0, 2}}));
+
+	TestIntMap patched{{0, 5}, {1, 6}};
+	JsonPatch<TestIntMap>::apply(patched, json);
+	QCOMPARE(patched, TestIntMap({{0, 2}, {1, 6}}));
+}
+
+void TestJsonSerializer::columnarEncoding()
+{
+	TestRoster roster;
+	roster.set_members({makePerson(QStringLiteral("A"), 18, {QStringLiteral("running"), QStringLiteral("TV")}), makePerson(QStringLiteral("B"), 16, {})});
+	QCOMPARE(compact(roster.toJson()), QByteArray("{\"members\":{\"$cols\":[\"name\",\"age\",\"hobbies\"],\"$rows\":[[\"A\",18,[\"running\",\"TV\"]],[\"B\",16,[]]]}}"));
+
+	TestRoster decoded;
+	decoded.fromJson(roster.toJson());
+	QCOMPARE(decoded.toCompactJson(), roster.toCompactJson());
+
+	{
+		JsonCompactKeysScope scope;
+		const QJsonObject json = roster.toJson();
+		QCOMPARE(json.value(QStringLiteral("a")).toObject().value(QStringLiteral("$cols")).toArray(), QJsonArray({QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c")}));
+		TestRoster compactDecoded;
+		compactDecoded.fromJson(json);
+		QCOMPARE(compactDecoded.toCompactJson(), roster.toCompactJson());
+	}
+
+	TestRoster plain;
+	plain.fromJson(QByteArray("{\"members\":[{\"name\":\"C\",\"age\":1}]}"));
+	QVERIFY(plain.ref_members().size() == 1);
+	QCOMPARE(plain.ref_members().first().name(), QStringLiteral("C"));
+}
+
+void TestJsonSerializer::aliasKeys()
+{
+	TestAliased value;
+	value.set_identifier(QStringLiteral("x"));
+	value.set_count(3);
+	value.set_label(QStringLiteral("L"));
+	QCOMPARE(value.toCompactJson(), QByteArray("{\"count\":3,\"identifier\":\"x\",\"label\":\"L\"}"));
+	QCOMPARE(compact(value.toJson()), value.toCompactJson());
+
+	// 显式短键名与不区分大小写的完整键名始终接受，自动短键名只在作用域中接受
+	TestAliased decoded{};
+	decoded.fromJson(QByteArray("{\"id\":\"y\",\"a\":5,\"LABEL\":\"M\"}"));
+	QCOMPARE(decoded.identifier(), QStringLiteral("y"));
+	QCOMPARE(decoded.count(), 0);
+	QCOMPARE(decoded.label(), QStringLiteral("M"));
+}
+
+void TestJsonSerializer::compactKeys()
+{
+	TestAliased value;
+	value.set_identifier(QStringLiteral("x"));
+	value.set_count(3);
+	value.set_label(QStringLiteral("L"));
+
+	JsonCompactKeysScope scope;
+	QCOMPARE(value.toCompactJson(), QByteArray("{\"a\":3,\"b\":\"L\",\"id\":\"x\"}"));
+	QCOMPARE(compact(value.toJson()), value.toCompactJson());
+
+	TestAliased decoded;
+	decoded.fromJson(value.toCompactJson());
+	QCOMPARE(decoded.identifier(), QStringLiteral("x"));
+	QCOMPARE(decoded.count(), 3);
+	QCOMPARE(decoded.label(), QStringLiteral("L"));
+
+	TestAliased full;
+	full.fromJson(QByteArray("{\"identifier\":\"z\",\"count\":4}"));
+	QCOMPARE(full.identifier(), QStringLiteral("z"));
+	QCOMPARE(full.count(), 4);
+}
+
+void TestJsonSerializer::aliasCollision()
+{
+	// 与 second 的完整键名冲突的显式短键名在建表时被忽略，first 改用自动短键名
+	QTest::ignoreMessage(QtWarningMsg, "JsonPropertyTable: alias \"second\" of TestAliasCollision::first collides with another key and is ignored");
+	TestAliasCollision value;
+	value.set_first(1);
+	value.set_second(2);
+	QCOMPARE(value.toCompactJson(), QByteArray("{\"first\":1,\"second\":2}"));
+
+	TestAliasCollision decoded{};
+	decoded.fromJson(QByteArray("{\"second\":2}"));
+	QCOMPARE(decoded.first(), 0);
+	QCOMPARE(decoded.second(), 2);
+
+	JsonCompactKeysScope scope;
+	QCOMPARE(value.toCompactJson(), QByteArray("{\"a\":1,\"b\":2}"));
+	TestAliasCollision compacted{};
+	compacted.fromJson(value.toCompactJson());
+	QCOMPARE(compacted.first(), 1);
+	QCOMPARE(compacted.second(), 2);
+}
+
+void TestJsonSerializer::deltaEncoding()
+{
+	TestSeries series;
+	series.set_stamps({Q_INT64_C(1700000000000), Q_INT64_C(1700000000250), Q_INT64_C(1700000000500)});
+	series.set_offsets({5, 3, 4});
+
+	const QJsonObject json = series.toJson();
+	const QJsonArray deltas = json.value(QStringLiteral("stamps")).toObject().value(QStringLiteral("$delta")).toArray();
+	QVERIFY(deltas.size() == 3);
+	QCOMPARE(deltas.at(0).toDouble(), 1700000000000.0);
+	QCOMPARE(deltas.at(1).toDouble(), 250.0);
+	QCOMPARE(deltas.at(2).toDouble(), 250.0);
+
+	// 差值 5、-2、1 经 zig-zag 变换为 10、3、2
+	const QJsonArray zigZag = json.value(QStringLiteral("offsets")).toObject().value(QStringLiteral("$zigzag")).toArray();
+	QVERIFY(zigZag.size() == 3);
+	QCOMPARE(zigZag.at(0).toDouble(), 10.0);
+	QCOMPARE(zigZag.at(1).toDouble(), 3.0);
+	QCOMPARE(zigZag.at(2).toDouble(), 2.0);
+
+	TestSeries decoded;
+	decoded.fromJson(json);
+	QVERIFY(decoded.ref_stamps() == series.ref_stamps());
+	QCOMPARE(decoded.ref_offsets(), series.ref_offsets());
+
+	TestSeries plain;
+	plain.fromJson(QByteArray("{\"offsets\":[1,2]}"));
+	QCOMPARE(plain.ref_offsets(), QVector<int>({1, 2}));
+}
+
+void TestJsonSerializer::jsonFields()
+{
+	const TestSample sample = makeSample();
+	const QByteArray expected("{\"name\":\"s\",\"ratio\":0.5,\"series\":[1,2,3],\"value\":7}");
+	QCOMPARE(JsonWriter::serialize(sample), expected);
+	QCOMPARE(compact(Serializer<TestSample>::toJson(sample).toObject()), expected);
+
+	const TestSample decoded = Serializer<TestSample>::fromJson(Serializer<TestSample>::toJson(sample));
+	QCOMPARE(decoded.name, sample.name);
+	QCOMPARE(decoded.value, sample.value);
+	QCOMPARE(decoded.ratio, sample.ratio);
+	QVERIFY(decoded.series == sample.series);
+
+	const QList<TestSample> samples{sample, sample};
+	QVERIFY(Serializer<QList<TestSample>>::fromJson(Serializer<QList<TestSample>>::toJson(samples)).size() == 2);
+}
+
+void TestJsonSerializer::generatedCodec()
+{
+	QVERIFY(JsonPropertyTable::of<TestGeneratedOrder>().hasGeneratedCodec());
+
+	TestGeneratedOrder order;
+	order.set_orderId(QStringLiteral("o-1"));
+	order.set_quantity(3);
+	order.set_tags({QStringLiteral("new"), QStringLiteral("gift")});
+
+	// toJson() 走生成的代码，toCompactJson() 走属性表的成员访问，两者输出一致
+	QCOMPARE(compact(order.toJson()), QByteArray("{\"orderId\":\"o-1\",\"quantity\":3,\"tags\":[\"new\",\"gift\"]}"));
+	QCOMPARE(compact(order.toJson()), order.toCompactJson());
+	{
+		JsonCompactKeysScope scope;
+		QCOMPARE(compact(order.toJson()), QByteArray("{\"a\":3,\"b\":[\"new\",\"gift\"],\"id\":\"o-1\"}"));
+		QCOMPARE(compact(order.toJson()), order.toCompactJson());
+		TestGeneratedOrder decoded;
+		decoded.fromJson(order.toJson());
+		QCOMPARE(decoded.quantity(), 3);
+	}
+
+	TestGeneratedOrder decoded;
+	decoded.fromJson(QByteArray("{\"ID\":\"o-1\",\"quantity\":3,\"tags\":[\"new\",\"gift\"],\"a\":9}"));
+	QCOMPARE(decoded.toCompactJson(), order.toCompactJson());
+
+	const std::vector<TestGeneratedOrder> orders{order, order};
+	const std::vector<TestGeneratedOrder> restored = Serializer<std::vector<TestGeneratedOrder>>::fromJson(Serializer<std::vector<TestGeneratedOrder>>::toJson(orders));
+	QVERIFY(restored.size() == 2);
+	QCOMPARE(restored.at(1).toCompactJson(), order.toCompactJson());
+}
+
+void TestJsonSerializer::fieldAccessors()
+{
+	// 基类与派生类的属性各自在静态初始化时登记，派生类的属性表取得全部成员访问接口
+	const JsonPropertyTable &circleTable = JsonPropertyTable::of<TestCircle>();
+	QVERIFY(circleTable.entries().size() == 2);
+	for (const JsonPropertyTable::Entry &entry : circleTable.entries())
+	{
+		QVERIFY2(entry.access != nullptr, qPrintable(entry.name));
+	}
+	for (const JsonPropertyTable::Entry &entry : JsonPropertyTable::of<TestPoint>().entries())
+	{
+		QVERIFY2(entry.access != nullptr, qPrintable(entry.name));
+	}
+
+	TestCircle circle;
+	circle.set_label(QStringLiteral("c"));
+	circle.set_radius(1.5);
+	QCOMPARE(circle.toCompactJson(), QByteArray("{\"label\":\"c\",\"radius\":1.5}"));
+	QCOMPARE(compact(circle.toJson()), circle.toCompactJson());
+}
+
+void TestJsonSerializer::cachedSerializable()
+{
+	TestCachedLeaf leaf;
+	leaf.set_title(QStringLiteral("t"));
+	leaf.set_rank(1);
+
+	// 命中缓存时返回同一份隐式共享的数据
+	const QByteArray first = leaf.toCompactJson();
+	QCOMPARE(first, QByteArray("{\"rank\":1,\"title\":\"t\"}"));
+	QVERIFY(leaf.toCompactJson().constData() == first.constData());
+
+	// 经由基类引用调用同样使用缓存
+	const JsonSerializable &base = leaf;
+	QVERIFY(base.toCompactJson().constData() == first.constData());
+	QCOMPARE(compact(base.toJson()), first);
+
+	leaf.set_rank(2);
+	QCOMPARE(leaf.toCompactJson(), QByteArray("{\"rank\":2,\"title\":\"t\"}"));
+
+	leaf.fromJson(QByteArray("{\"title\":\"u\"}"));
+	QCOMPARE(leaf.toCompactJson(), QByteArray("{\"rank\":2,\"title\":\"u\"}"));
+
+	{
+		JsonCompactKeysScope scope;
+		QCOMPARE(leaf.toCompactJson(), QByteArray("{\"a\":\"u\",\"b\":2}"));
+	}
+	QCOMPARE(leaf.toCompactJson(), QByteArray("{\"rank\":2,\"title\":\"u\"}"));
+}
+
+void TestJsonSerializer::cachedSerializableThreads()
+{
+	TestCachedLeaf leaf;
+	leaf.set_title(QStringLiteral("t"));
+	leaf.set_rank(1);
+	const QByteArray expected("{\"rank\":1,\"title\":\"t\"}");
+
+	// 多个线程同时序列化同一个未修改的对象，缓存以原子方式发布
+	std::vector<std::thread> threads;
+	std::atomic<int> mismatches{0};
+	for (int i = 0; i < 4; i++)
+	{
+		threads.emplace_back([&leaf, &expected, &mismatches]() {
+			for (int j = 0; j < 200; j++)
+			{
+				if (leaf.toCompactJson() != expected)
+				{
+					mismatches++;
+				}
+			}
+		});
+	}
+	for (std::thread &thread : threads)
+	{
+		thread.join();
+	}
+	QCOMPARE(mismatches.load(), 0);
+
+	// 复制对象共享缓存，修改副本不影响原对象
+	TestCachedLeaf copy = leaf;
+	QVERIFY(copy.toCompactJson().constData() == leaf.toCompactJson().constData());
+	copy.set_rank(2);
+	QCOMPARE(copy.toCompactJson(), QByteArray("{\"rank\":2,\"title\":\"t\"}"));
+	QCOMPARE(leaf.toCompactJson(), expected);
+}
+
+void TestJsonSerializer::cachedSerializableReferenceScope()
+{
+	TestCachedLeaf leaf;
+	leaf.set_title(QStringLiteral("t"));
+	leaf.set_rank(1);
+	const QByteArray cached = leaf.toCompactJson();
+
+	{
+		JsonReferenceScope scope;
+		const QByteArray scoped = leaf.toCompactJson();
+		QCOMPARE(scoped, cached);
+		QVERIFY(scoped.constData() != cached.constData());
+	}
+
+	auto shared = std::make_shared<TestCachedLeaf>(leaf);
+	TestCachedHolder holder;
+	holder.set_leaves({shared, shared});
+	const QByteArray plain = holder.toCompactJson();
+	QVERIFY(!plain.contains("$ref"));
+	{
+		JsonReferenceScope scope;
+		QVERIFY(holder.toCompactJson().contains("$ref"));
+	}
+	QCOMPARE(holder.toCompactJson(), plain);
+}
+
+void TestJsonSerializer::cachedSerializableSharedMembers()
+{
+	auto shared = std::make_shared<TestCachedLeaf>();
+	shared->set_title(QStringLiteral("before"));
+	TestCachedHolder holder;
+	holder.set_leaves({shared});
+	QVERIFY(JsonPropertyTable::of<TestCachedHolder>().hasSharedMembers());
+	QVERIFY(!JsonPropertyTable::of<TestCachedLeaf>().hasSharedMembers());
+
+	const QByteArray before = holder.toCompactJson();
+	QVERIFY(before.contains("before"));
+
+	// 不经 holder 的 setter 修改被指向的对象，输出仍然反映修改
+	shared->set_title(QStringLiteral("after"));
+	const QByteArray after = holder.toCompactJson();
+	QVERIFY(after.contains("after"));
+	QCOMPARE(compact(holder.toJson()), after);
+}
+
+void TestJsonSerializer::mergePatchDiff()
+{
+	TestInventory before;
+	before.set_owner(QStringLiteral("a"));
+	before.set_counts({{QStringLiteral("x"), 1}, {QStringLiteral("y"), 2}});
+	TestInventory after = before;
+	after.set_counts({{QStringLiteral("x"), 1}, {QStringLiteral("z"), 3}});
+
+	// 只输出变化的属性；映射中删除的键为 null
+	QCOMPARE(compact(JsonMergePatch::diff(before, after)), QByteArray("{\"counts\":{\"y\":null,\"z\":3}}"));
+	QVERIFY(JsonMergePatch::diff(after, after).isEmpty());
+
+	after.set_owner(QString());
+	after.set_flags({true});
+	QCOMPARE(compact(JsonMergePatch::diff(before, after)), QByteArray("{\"counts\":{\"y\":null,\"z\":3},\"flags\":[true],\"owner\":\"\"}"));
+
+	// 嵌套对象生成嵌套补丁
+	const TestPagedPerson paged = makePaged(2);
+	TestPagedPerson changed = paged;
+	TestPageInfo page = changed.page();
+	page.set_currentPage(2);
+	changed.set_page(page);
+	QCOMPARE(compact(JsonMergePatch::diff(paged, changed)), QByteArray("{\"page\":{\"currentPage\":2}}"));
+}
+
+void TestJsonSerializer::mergePatchApply()
+{
+	TestInventory before;
+	before.set_owner(QStringLiteral("a"));
+	before.set_counts({{QStringLiteral("x"), 1}, {QStringLiteral("y"), 2}});
+	TestInventory after = before;
+	after.set_counts({{QStringLiteral("x"), 1}, {QStringLiteral("z"), 3}});
+
+	TestInventory target = before;
+	JsonMergePatch::apply(target, JsonMergePatch::diff(before, after));
+	QCOMPARE(target.toCompactJson(), after.toCompactJson());
+
+	// null 恢复默认值，补丁中没有的属性保持不变
+	JsonMergePatch::apply(target, QJsonObject{{QStringLiteral("owner"), QJsonValue()}});
+	QCOMPARE(target.owner(), QString());
+	QVERIFY(target.ref_counts().size() == 2);
+
+	// 嵌套补丁原地修改，不涉及的成员保留原有存储
+	const TestPagedPerson paged = makePaged(3);
+	TestPagedPerson changed = paged;
+	TestPageInfo page = changed.page();
+	page.set_currentPage(2);
+	changed.set_page(page);
+	TestPagedPerson patched = paged;
+	const TestPerson *storage = patched.ref_persons().data();
+	JsonMergePatch::apply(patched, JsonMergePatch::diff(paged, changed));
+	QCOMPARE(patched.toCompactJson(), changed.toCompactJson());
+	QVERIFY(patched.ref_persons().data() == storage);
+
+	// 元素个数不变的数组逐个元素赋值
+	changed = patched;
+	std::vector<TestPerson> persons = changed.persons();
+	persons[1].set_name(QStringLiteral("Q"));
+	changed.set_persons(persons);
+	JsonMergePatch::apply(patched, JsonMergePatch::diff(patched, changed));
+	QCOMPARE(patched.toCompactJson(), changed.toCompactJson());
+	QVERIFY(patched.ref_persons().data() == storage);
+}
+
+void TestJsonSerializer::fingerprintVectors()
+{
+	// XXH64 的公开测试向量
+	QCOMPARE(JsonHash64::hash(QByteArray()), Q_UINT64_C(0xEF46DB3751D8E999));
+	QCOMPARE(JsonHash64::hash(QByteArray("a")), Q_UINT64_C(0xD24EC4F1A98C6E5B));
+	QCOMPARE(JsonHash64::hash(QByteArray("abc")), Q_UINT64_C(0x44BC2CF5AD770999));
+	QCOMPARE(JsonHash64::hash(QByteArray("Nobody inspects the spammish repetition")), Q_UINT64_C(0xFBCEA83C8A378BF1));
+	const QByteArray fox("The quick brown fox jumps over the lazy dog");
+	QCOMPARE(JsonHash64::hash(fox), Q_UINT64_C(0x0B242D361FDA71BC));
+	QCOMPARE(JsonHash64::hash(QByteArray(), 1), Q_UINT64_C(0xD5AFBA1336A3BE4B));
+
+	// 分块输入与一次输入的结果相同，空输入不访问数据指针
+	JsonHash64 hasher;
+	for (int i = 0; i < fox.size(); i += 5)
+	{
+		const QByteArray chunk = fox.mid(i, 5);
+		hasher.addData(chunk.constData(), chunk.size());
+		hasher.addData(nullptr, 0);
+	}
+	QCOMPARE(hasher.result(), Q_UINT64_C(0x0B242D361FDA71BC));
+}
+
+void TestJsonSerializer::fingerprintCanonical()
+{
+	const TestSample sample = makeSample();
+	const quint64 fingerprint = JsonFingerprint::of(sample);
+	QCOMPARE(fingerprint, JsonFingerprint::ofJson(JsonWriter::serialize(sample)));
+
+	const TestPagedPerson paged = makePaged(3);
+	const quint64 pagedFingerprint = JsonFingerprint::of(paged);
+	QCOMPARE(pagedFingerprint, JsonFingerprint::ofJson(paged.toCompactJson()));
+
+	// 短键名与浮点精度设置改变输出，但不影响指纹
+	TestSample precise = sample;
+	precise.ratio = 0.123456789;
+	const quint64 full = JsonFingerprint::of(precise);
+	const QByteArray exact = JsonWriter::serialize(precise);
+	{
+		JsonCompactKeysScope keysScope;
+		JsonFloatPrecisionScope precisionScope(JsonFloatPrecision::decimals(2));
+		QVERIFY(JsonWriter::serialize(precise) != exact);
+		QVERIFY(paged.toCompactJson().contains("\"a\":"));
+		QCOMPARE(JsonFingerprint::of(precise), full);
+		QCOMPARE(JsonFingerprint::of(paged), pagedFingerprint);
+	}
+	QVERIFY(JsonFingerprint::of(precise) != fingerprint);
+	QVERIFY(JsonFingerprint::of(sample, 1) != fingerprint);
+}
+
+void TestJsonSerializer::overwriteDecode()
+{
+	TestPagedPerson scratch = makePaged(3);
+	const TestPerson *storage = scratch.ref_persons().data();
+	TestPagedPerson incoming = makePaged(3);
+	incoming.set_persons({makePerson(QStringLiteral("X"), 1, {}), makePerson(QStringLiteral("Y"), 2, {}), makePerson(QStringLiteral("Z"), 3, {})});
+
+	// 形状相同的消息逐个元素覆盖，不重新分配
+	scratch.overwriteFromJson(QJsonValue(incoming.toJson()));
+	QCOMPARE(scratch.toCompactJson(), incoming.toCompactJson());
+	QVERIFY(scratch.ref_persons().data() == storage);
+
+	// 缺少的属性恢复默认值，容器保留容量
+	scratch.overwriteFromJson(QByteArray("{\"persons\":[]}"));
+	QCOMPARE(scratch.ref_page().totalNumber(), 0);
+	QVERIFY(scratch.ref_persons().empty());
+	QVERIFY(scratch.ref_persons().capacity() >= 3);
+
+	TestPagedPerson fresh;
+	fresh.fromJson(incoming.toJson());
+	scratch.overwriteFromJson(QJsonValue(incoming.toJson()));
+	QCOMPARE(scratch.toCompactJson(), fresh.toCompactJson());
+
+	// std::vector<bool> 的元素是代理引用，按值赋值
+	TestInventory inventory;
+	inventory.set_counts({{QStringLiteral("stale"), 1}});
+	inventory.set_flags({true, true});
+	inventory.overwriteFromJson(QByteArray("{\"owner\":\"b\",\"flags\":[false,true,true]}"));
+	QCOMPARE(inventory.owner(), QStringLiteral("b"));
+	QVERIFY(inventory.ref_counts().isEmpty());
+	QVERIFY(inventory.ref_flags() == std::vector<bool>({false, true, true}));
+
+	std::vector<bool> flags{true};
+	JsonAssign<std::vector<bool>>::assign(flags, QJsonArray({false, false}));
+	QVERIFY(flags == std::vector<bool>({false, false}));
+}
+
+void TestJsonSerializer::decodeCache()
+{
+	JsonDecodeCache<TestPerson> cache(2);
+	const QByteArray first("{\"name\":\"A\",\"age\":1}");
+	const QByteArray second("{\"name\":\"B\",\"age\":2}");
+	const QByteArray third("{\"name\":\"C\",\"age\":3}");
+
+	std::shared_ptr<const TestPerson> a = cache.fromJson(first);
+	QVERIFY(a);
+	QCOMPARE(a->name(), QStringLiteral("A"));
+	QCOMPARE(a->age(), 1);
+
+	// 内容相同的另一份输入返回同一个对象
+	QVERIFY(cache.fromJson(QByteArray(first.constData(), first.size())) == a);
+	QCOMPARE(cache.hits(), quint64(1));
+	QCOMPARE(cache.size(), 1);
+
+	QVERIFY(!cache.fromJson(QByteArray("{\"name\":")));
+	QCOMPARE(cache.size(), 1);
+
+	// 超过条目数时淘汰最久未使用的条目
+	QVERIFY(cache.fromJson(second));
+	QVERIFY(cache.fromJson(third));
+	QCOMPARE(cache.size(), 2);
+	std::shared_ptr<const TestPerson> reloaded = cache.fromJson(first);
+	QVERIFY(reloaded != a);
+	QCOMPARE(reloaded->name(), QStringLiteral("A"));
+	QCOMPARE(a->name(), QStringLiteral("A"));
+
+	cache.setLimits(2, 0);
+	QCOMPARE(cache.size(), 0);
+	QCOMPARE(cache.bytes(), qint64(0));
+}
+
+void TestJsonSerializer::keyOrderSpeculation()
+{
+	const TestPerson person = makePerson(QStringLiteral("A"), 3, {QStringLiteral("x")});
+	const QByteArray full = person.toCompactJson();
+	for (int i = 0; i < 3; i++)
+	{
+		TestPerson decoded;
+		decoded.fromJson(full);
+		QCOMPARE(decoded.toCompactJson(), full);
+
+		// 只有一个键的对象直接查找，不覆盖完整对象的记录
+		TestPerson single;
+		single.fromJson(QByteArray("{\"name\":\"S\"}"));
+		QCOMPARE(single.name(), QStringLiteral("S"));
+
+		// 形状不同的文档推测失败，回退到查找
+		TestPerson partial;
+		partial.overwriteFromJson(QByteArray("{\"hobbies\":[],\"NAME\":\"B\"}"));
+		QCOMPARE(partial.name(), QStringLiteral("B"));
+		QCOMPARE(partial.age(), 0);
+	}
+
+	// 推测命中的属性同样只在短键名作用域中接受自动短键名
+	QByteArray compactKeys;
+	{
+		JsonCompactKeysScope scope;
+		compactKeys = person.toCompactJson();
+		TestPerson decoded;
+		decoded.fromJson(compactKeys);
+		QCOMPARE(decoded.toCompactJson(), compactKeys);
+	}
+	TestPerson outside;
+	outside.fromJson(compactKeys);
+	QCOMPARE(outside.name(), QString());
+}
+
+QTEST_GUILESS_MAIN(TestJsonSerializer)
+
+#include "tst_JsonSerializer.moc"
@@ -0,0 +1,306 @@
+// File: tst_JsonStreaming
+// Author: linxmouse@gmail.com
+// Creation: 2024/09/29
+#include <QtTest>
+#include "JsonSerializerIncremental.h"
+#include "JsonSerializerPipeline.h"
+#include "JsonSerializerTimeSliced.h"
+#include "TestPagedPerson.h"
+
+static TestPerson makePerson(const QString &name, int age, const QList<QString> &hobbies)
+{
+	TestPerson person;
+	person.set_name(name);
+	person.set_age(age);
+	person.set_hobbies(hobbies);
+	return person;
+}
+
+static TestPagedPerson makePaged(int count)
+{
+	TestPageInfo page;
+	page.set_totalNumber(count);
+	page.set_totalPage(1);
+	page.set_pageSize(count);
+	page.set_currentPage(1);
+	std::vector<TestPerson> persons;
+	for (int i = 0; i < count; i++)
+	{
+		persons.push_back(makePerson(QStringLiteral("P%1").arg(i), 20 + i % 50, {QStringLiteral("reading"), QStringLiteral("a,}\"]")}));
+	}
+	TestPagedPerson paged;
+	paged.set_page(page);
+	paged.set_persons(std::move(persons));
+	return paged;
+}
+
+/**
+ * @brief 按固定大小分块输入
+ */
+template <typename Decoder>
+static void feedChunks(Decoder &decoder, const QByteArray &data, int chunkSize)
+{
+	for (int i = 0; i < data.size(); i += chunkSize)
+	{
+		decoder.feed(data.mid(i, chunkSize));
+	}
+}
+
+class TestJsonStreaming : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void incrementalObject();
+	void incrementalMemberArray();
+	void incrementalArray();
+	void incrementalScalar();
+	void incrementalErrors();
+	void incrementalKeyOrder();
+	void pipelineObject();
+	void pipelineArray();
+	void pipelineErrors();
+	void timeSlicedSteps();
+	void timeSlicedEventLoop();
+};
+
+void TestJsonStreaming::incrementalObject()
+{
+	const TestPagedPerson paged = makePaged(50);
+	// 缩进格式的输出带有空白，字符串中含有逗号、括号与转义的引号
+	const QByteArray data = paged.toRawJson();
+	for (int chunkSize : {1, 7, 4096})
+	{
+		JsonIncrementalDecoder<TestPagedPerson> decoder;
+		feedChunks(decoder, data, chunkSize);
+		QVERIFY(decoder.isFinished());
+		QVERIFY(decoder.finish());
+		QCOMPARE(decoder.value().toCompactJson(), paged.toCompactJson());
+	}
+}
+
+void TestJsonStreaming::incrementalMemberArray()
+{
+	const TestPagedPerson paged = makePaged(50);
+	const QByteArray data = paged.toCompactJson();
+
+	// persons 数组逐个元素追加：输入一部分时已经解码出前面的元素
+	JsonIncrementalDecoder<TestPagedPerson> decoder;
+	decoder.value().set_persons({makePerson(QStringLiteral("stale"), 1, {})});
+	decoder.feed(data.left(data.size() / 2));
+	QVERIFY(!decoder.isFinished());
+	QVERIFY(!decoder.value().persons().empty());
+	QVERIFY(decoder.value().persons().size() < paged.persons().size());
+	QCOMPARE(decoder.value().persons().front().name(), QStringLiteral("P0"));
+	decoder.feed(data.mid(data.size() / 2));
+	QVERIFY(decoder.finish());
+	QCOMPARE(decoder.value().toCompactJson(), data);
+
+	// 空数组与非对象元素的数组整体写入
+	JsonIncrementalDecoder<TestPagedPerson> empty;
+	feedChunks(empty, QByteArray("{\"persons\" : [ ] }"), 1);
+	QVERIFY(empty.finish());
+	QVERIFY(empty.value().persons().empty());
+
+	JsonIncrementalDecoder<TestPerson> person;
+	feedChunks(person, QByteArray("{\"hobbies\": [\"a\", \"b\"], \"age\": 3}"), 3);
+	QVERIFY(person.finish());
+	QCOMPARE(person.value().hobbies(), QList<QString>({QStringLiteral("a"), QStringLiteral("b")}));
+	QCOMPARE(person.value().age(), 3);
+
+	// 不可序列化的目标缓存数组元素，结束时整体写入
+	JsonIncrementalDecoder<QJsonValue> tree;
+	feedChunks(tree, data, 64);
+	QVERIFY(tree.finish());
+	QCOMPARE(tree.value().toObject(), QJsonDocument::fromJson(data).object());
+
+	// 成员数组以 } 结束
+	JsonIncrementalDecoder<TestPagedPerson> mismatched;
+	mismatched.feed(QByteArray("{\"persons\":[{}}}"));
+	QVERIFY(!mismatched.finish());
+}
+
+void TestJsonStreaming::incrementalArray()
+{
+	const std::vector<TestPerson> persons = makePaged(20).persons();
+	const QByteArray data = JsonWriter::serialize(persons);
+	JsonIncrementalDecoder<std::vector<TestPerson>> decoder;
+	feedChunks(decoder, data, 5);
+	QVERIFY(decoder.finish());
+	QCOMPARE(JsonWriter::serialize(decoder.value()), data);
+
+	JsonIncrementalDecoder<QList<int>> numbers;
+	feedChunks(numbers, QByteArray(" [1, 2,3 ] "), 2);
+	QVERIFY(numbers.finish());
+	QCOMPARE(numbers.value(), QList<int>({1, 2, 3}));
+}
+
+void TestJsonStreaming::incrementalScalar()
+{
+	JsonIncrementalDecoder<int> number;
+	number.feed(QByteArray(" 4"));
+	number.feed(QByteArray("2 "));
+	QVERIFY(number.finish());
+	QCOMPARE(number.value(), 42);
+
+	JsonIncrementalDecoder<QString> text;
+	feedChunks(text, QByteArray("\"a,\\\"b\""), 1);
+	QVERIFY(text.finish());
+	QCOMPARE(text.value(), QStringLiteral("a,\"b"));
+}
+
+void TestJsonStreaming::incrementalErrors()
+{
+	const QByteArray data = makePaged(5).toCompactJson();
+
+	JsonIncrementalDecoder<TestPagedPerson> truncated;
+	truncated.feed(data.left(data.size() / 2));
+	QVERIFY(!truncated.isFinished());
+	QVERIFY(!truncated.finish());
+
+	JsonIncrementalDecoder<TestPagedPerson> trailing;
+	trailing.feed(data + "{}");
+	QVERIFY(!trailing.finish());
+
+	JsonIncrementalDecoder<TestPagedPerson> empty;
+	QVERIFY(!empty.finish());
+
+	// 标量根之后的多余值
+	for (const char *extra : {"1 2", "1,2", "1]"})
+	{
+		JsonIncrementalDecoder<int> scalar;
+		feedChunks(scalar, QByteArray(extra), 1);
+		QVERIFY(!scalar.finish());
+	}
+}
+
+void TestJsonStreaming::incrementalKeyOrder()
+{
+	// 成员按文档中的顺序（而不是 QJsonObject 的排序）推测，交替的键序同样得到正确结果
+	const QList<QByteArray> documents{
+		QByteArray("{\"name\":\"A\",\"hobbies\":[\"x\"],\"age\":1}"),
+		QByteArray("{\"age\":2,\"name\":\"B\",\"hobbies\":[]}"),
+	};
+	for (int i = 0; i < 4; i++)
+	{
+		const QByteArray &data = documents.at(i % 2);
+		JsonIncrementalDecoder<TestPerson> decoder;
+		feedChunks(decoder, data, 4);
+		QVERIFY(decoder.finish());
+		TestPerson expected;
+		expected.fromJson(data);
+		QCOMPARE(decoder.value().toCompactJson(), expected.toCompactJson());
+	}
+}
+
+void TestJsonStreaming::pipelineObject()
+{
+	const TestPagedPerson paged = makePaged(2000);
+	const QByteArray data = paged.toCompactJson();
+
+	// chunkBytes 远小于文档，persons 数组按元素切分后并行解析
+	JsonPipelineOptions options;
+	options.workers = 3;
+	options.chunkBytes = 1024;
+	options.blockSize = 4;
+	options.queueCapacity = 4;
+	// 各段的元素在解码线程中解码为 TestPerson，拼接后替换原有的元素
+	TestPagedPerson decoded;
+	decoded.set_persons({makePerson(QStringLiteral("stale"), 1, {})});
+	QVERIFY(JsonPipelineDecoder<TestPagedPerson>::decode(data, decoded, options));
+	QCOMPARE(decoded.toCompactJson(), data);
+
+	// 小于 chunkBytes 的文档直接解码
+	const TestPagedPerson small = makePaged(2);
+	QCOMPARE(JsonPipelineDecoder<TestPagedPerson>::fromJson(small.toCompactJson()).toCompactJson(), small.toCompactJson());
+}
+
+void TestJsonStreaming::pipelineArray()
+{
+	const std::vector<TestPerson> persons = makePaged(1000).persons();
+	const QByteArray data = JsonWriter::serialize(persons);
+	JsonPipelineOptions options;
+	options.workers = 2;
+	options.chunkBytes = 512;
+	std::vector<TestPerson> decoded{makePerson(QStringLiteral("stale"), 1, {})};
+	QVERIFY(JsonPipelineDecoder<std::vector<TestPerson>>::decode(data, decoded, options));
+	QCOMPARE(JsonWriter::serialize(decoded), data);
+}
+
+void TestJsonStreaming::pipelineErrors()
+{
+	const QByteArray data = makePaged(500).toCompactJson();
+	JsonPipelineOptions options;
+	options.workers = 2;
+	options.chunkBytes = 256;
+
+	TestPagedPerson truncated;
+	QVERIFY(!JsonPipelineDecoder<TestPagedPerson>::decode(data.left(data.size() - 10), truncated, options));
+
+	TestPagedPerson wrongRoot;
+	QVERIFY(!JsonPipelineDecoder<TestPagedPerson>::decode("[" + data + "]", wrongRoot, options));
+}
+
+void TestJsonStreaming::timeSlicedSteps()
+{
+	const TestPagedPerson paged = makePaged(200);
+	JsonTimeSlicedEncoder<TestPagedPerson> encoder(paged);
+	int steps = 0;
+	while (!encoder.step(512))
+	{
+		steps++;
+	}
+	QVERIFY(steps > 1);
+	QVERIFY(encoder.isFinished());
+	QCOMPARE(encoder.takeResult(), paged.toCompactJson());
+
+	const std::vector<TestPerson> persons = paged.persons();
+	JsonTimeSlicedEncoder<std::vector<TestPerson>> sequence(persons);
+	while (!sequence.step(256))
+	{
+	}
+	QCOMPARE(sequence.takeResult(), JsonWriter::serialize(persons));
+
+	// 构造时的短键名设置在每一步中保持不变
+	QByteArray compactKeys;
+	{
+		JsonCompactKeysScope scope;
+		compactKeys = paged.toCompactJson();
+	}
+	std::unique_ptr<JsonTimeSlicedEncoder<TestPagedPerson>> scoped;
+	{
+		JsonCompactKeysScope scope;
+		scoped.reset(new JsonTimeSlicedEncoder<TestPagedPerson>(paged));
+	}
+	while (!scoped->step(512))
+	{
+	}
+	QCOMPARE(scoped->takeResult(), compactKeys);
+}
+
+void TestJsonStreaming::timeSlicedEventLoop()
+{
+	const TestPagedPerson paged = makePaged(500);
+	QObject context;
+	QByteArray result;
+	bool done = false;
+	JsonTimeSliced::toCompactJson(paged, &context, 1, [&result, &done](const QByteArray &json) {
+		result = json;
+		done = true;
+	});
+	QVERIFY(!done);
+	QTRY_VERIFY(done);
+	QCOMPARE(result, paged.toCompactJson());
+
+	// 停止返回的定时器即取消编码，不再调用回调
+	bool called = false;
+	QTimer *timer = JsonTimeSliced::toCompactJson(paged, &context, 1, [&called](const QByteArray &) { called = true; });
+	timer->stop();
+	timer->deleteLater();
+	QTest::qWait(20);
+	QVERIFY(!called);
+}
+
+QTEST_GUILESS_MAIN(TestJsonStreaming)
+
+#include "tst_JsonStreaming.moc"
@@ -0,0 +1,818 @@
+// File: JsonSerializerGen
+// Author: linxmouse@gmail.com
+// Creation: 2024/09/29
+//
+// 根据头文件中的 JSON_PROPERTY 声明生成专用的序列化代码
+// 用法：JsonSerializerGen <输入头文件> <输出源文件>
+//
+// 生成的源文件为每个可序列化类特化 JsonGeneratedCodec<T>，并以 JSON_REGISTER_GENERATED 登记到类的属性表：
+// 编码时按声明顺序通过 ref_xxx() 读取成员并插入预先生成的常量键，
+// 解码时按键长度 switch 分派到属性下标，再通过 set_xxx() 写入成员
+// 特化只存在于生成的源文件中，包含原头文件的其他翻译单元不受影响
+// 工具只依赖标准库，可在交叉编译时作为宿主程序构建
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 单个 JSON 属性声明
+ */
+struct JsonGenProperty
+{
+	std::string type;  ///< 属性的数据类型
+	std::string name;  ///< 属性名称（完整键名）
+	std::string codec; ///< 编解码使用的序列化器
+	std::string alias; ///< 短键名，未显式声明时自动分配
+	bool autoAlias = false; ///< 短键名是否为自动分配
+};
+
+/**
+ * @brief 含有 JSON 属性的类
+ */
+struct JsonGenClass
+{
+	std::string name;                        ///< 限定类名
+	std::vector<std::string> bases;          ///< 基类列表
+	std::vector<JsonGenProperty> properties; ///< 本类声明的属性
+};
+
+/**
+ * @brief 头文件扫描器
+ * @details
+ * 不做完整的 C++ 解析，只识别命名空间、类定义、局部 #include 与 JSON_PROPERTY 系列宏，
+ * 足以覆盖 JSON_SERIALIZABLE 风格的 DTO 头文件
+ */
+class JsonGenScanner
+{
+public:
+	explicit JsonGenScanner(const std::string &text)
+		: m_text(stripComments(text))
+	{
+	}
+
+	bool scan(std::string &error)
+	{
+		struct Scope
+		{
+			int classIndex; ///< 类作用域对应的下标，其他作用域为 -1
+			std::string name;
+		};
+		std::vector<Scope> scopes;
+		std::string pendingName;
+		int pendingClass = -1;
+		std::string lastWord;
+
+		size_t i = 0;
+		while (i < m_text.size())
+		{
+			char c = m_text[i];
+			if (c == '#' && atLineStart(i))
+			{
+				i = scanDirective(i);
+				continue;
+			}
+			if (c == '"' || c == '\'')
+			{
+				i = skipLiteral(i);
+				continue;
+			}
+			if (isIdentStart(c))
+			{
+				size_t begin = i;
+				while (i < m_text.size() && isIdentChar(m_text[i]))
+				{
+					i++;
+				}
+				std::string word = m_text.substr(begin, i - begin);
+				if (word == "namespace")
+				{
+					size_t end = m_text.find_first_of("{;=", i);
+					if (end != std::string::npos && m_text[end] == '{')
+					{
+						pendingName = trim(m_text.substr(i, end - i));
+						pendingClass = -1;
+					}
+				}
+				else if ((word == "class" || word == "struct") && lastWord != "enum" && lastWord != "friend")
+				{
+					i = scanClassHead(i, scopes.empty() ? std::string() : qualifiedPrefix(scopes), pendingName, pendingClass);
+				}
+				else if (word.compare(0, 13, "JSON_PROPERTY") == 0 && !scopes.empty() && scopes.back().classIndex >= 0)
+				{
+					size_t open = skipSpace(i);
+					if (open < m_text.size() && m_text[open] == '(')
+					{
+						std::vector<std::string> args;
+						i = splitArguments(open, args);
+						if (!addProperty(m_classes[scopes.back().classIndex], word, args, error))
+						{
+							return false;
+						}
+					}
+				}
+				lastWord = word;
+				continue;
+			}
+			if (c == '{')
+			{
+				scopes.push_back({pendingClass, pendingName});
+				pendingName.clear();
+				pendingClass = -1;
+			}
+			else if (c == '}')
+			{
+				if (scopes.empty())
+				{
+					error = "unbalanced braces";
+					return false;
+				}
+				scopes.pop_back();
+			}
+			else if (c == ';')
+			{
+				pendingName.clear();
+				pendingClass = -1;
+			}
+			if (!std::isspace(static_cast<unsigned char>(c)))
+			{
+				lastWord.clear();
+			}
+			i++;
+		}
+		return true;
+	}
+
+	const std::vector<JsonGenClass> &classes() const
+	{
+		return m_classes;
+	}
+
+private:
+	static bool isIdentStart(char c)
+	{
+		return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+	}
+
+	static bool isIdentChar(char c)
+	{
+		return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+	}
+
+	static std::string trim(const std::string &text)
+	{
+		size_t begin = text.find_first_not_of(" \t\r\n");
+		if (begin == std::string::npos)
+		{
+			return std::string();
+		}
+		size_t end = text.find_last_not_of(" \t\r\n");
+		return text.substr(begin, end - begin + 1);
+	}
+
+	/**
+	 * @brief 移除注释，保留换行以便预处理指令仍按行识别
+	 */
+	static std::string stripComments(const std::string &text)
+	{
+		std::string result;
+		result.reserve(text.size());
+		size_t i = 0;
+		while (i < text.size())
+		{
+			if (text.compare(i, 2, "//") == 0)
+			{
+				while (i < text.size() && text[i] != '\n')
+				{
+					i++;
+				}
+			}
+			else if (text.compare(i, 2, "/*") == 0)
+			{
+				size_t end = text.find("*/", i + 2);
+				end = end == std::string::npos ? text.size() : end + 2;
+				result.append(std::count(text.begin() + i, text.begin() + end, '\n'), '\n');
+				i = end;
+			}
+			else if (text[i] == '"' || text[i] == '\'')
+			{
+				char quote = text[i];
+				result += text[i++];
+				while (i < text.size() && text[i] != quote && text[i] != '\n')
+				{
+					if (text[i] == '\\' && i + 1 < text.size())
+					{
+						result += text[i++];
+					}
+					result += text[i++];
+				}
+				if (i < text.size())
+				{
+					result += text[i++];
+				}
+			}
+			else
+			{
+				result += text[i++];
+			}
+		}
+		return result;
+	}
+
+	bool atLineStart(size_t pos) const
+	{
+		while (pos > 0)
+		{
+			char c = m_text[--pos];
+			if (c == '\n')
+			{
+				return true;
+			}
+			if (c != ' ' && c != '\t')
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	size_t skipSpace(size_t pos) const
+	{
+		while (pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[pos])))
+		{
+			pos++;
+		}
+		return pos;
+	}
+
+	size_t skipLiteral(size_t pos) const
+	{
+		char quote = m_text[pos++];
+		while (pos < m_text.size() && m_text[pos] != quote)
+		{
+			pos += m_text[pos] == '\\' ? 2 : 1;
+		}
+		return pos + 1;
+	}
+
+	/**
+	 * @brief 跳过预处理指令（包括续行）
+	 */
+	size_t scanDirective(size_t pos)
+	{
+		size_t end = pos;
+		while (end < m_text.size() && m_text[end] != '\n')
+		{
+			end += m_text[end] == '\\' ? 2 : 1;
+		}
+		return end;
+	}
+
+	std::string qualifiedPrefix(const std::vector<std::string> &names) const
+	{
+		std::string prefix;
+		for (const std::string &name : names)
+		{
+			if (!name.empty())
+			{
+				prefix += name + "::";
+			}
+		}
+		return prefix;
+	}
+
+	template <typename Scopes>
+	std::string qualifiedPrefix(const Scopes &scopes) const
+	{
+		std::vector<std::string> names;
+		for (const auto &scope : scopes)
+		{
+			names.push_back(scope.name);
+		}
+		return qualifiedPrefix(names);
+	}
+
+	/**
+	 * @brief 解析类头，类定义时登记类并设置待进入的作用域
+	 */
+	size_t scanClassHead(size_t pos, const std::string &prefix, std::string &pendingName, int &pendingClass)
+	{
+		pos = skipSpace(pos);
+		size_t begin = pos;
+		while (pos < m_text.size() && isIdentChar(m_text[pos]))
+		{
+			pos++;
+		}
+		std::string name = m_text.substr(begin, pos - begin);
+		size_t end = pos;
+		int depth = 0;
+		while (end < m_text.size())
+		{
+			char c = m_text[end];
+			if (c == '<' || c == '(')
+			{
+				depth++;
+			}
+			else if (c == '>' || c == ')')
+			{
+				if (--depth < 0)
+				{
+					return pos;
+				}
+			}
+			else if (depth == 0 && (c == '{' || c == ';' || c == '=' || c == ','))
+			{
+				break;
+			}
+			end++;
+		}
+		if (name.empty() || end >= m_text.size() || m_text[end] != '{')
+		{
+			return pos;
+		}
+
+		JsonGenClass cls;
+		cls.name = prefix + name;
+		std::string head = m_text.substr(pos, end - pos);
+		size_t colon = head.find(':');
+		if (colon != std::string::npos)
+		{
+			for (std::string base : splitTopLevel(head.substr(colon + 1)))
+			{
+				for (const char *keyword : {"public ", "protected ", "private ", "virtual "})
+				{
+					size_t found = base.find(keyword);
+					if (found != std::string::npos)
+					{
+						base.erase(found, std::string(keyword).size());
+					}
+				}
+				cls.bases.push_back(trim(base));
+			}
+		}
+		m_classes.push_back(cls);
+		pendingName = name;
+		pendingClass = static_cast<int>(m_classes.size()) - 1;
+		return end;
+	}
+
+	static std::vector<std::string> splitTopLevel(const std::string &text)
+	{
+		std::vector<std::string> parts;
+		std::string current;
+		int depth = 0;
+		for (char c : text)
+		{
+			if (c == '<' || c == '(' || c == '[' || c == '{')
+			{
+				depth++;
+			}
+			else if (c == '>' || c == ')' || c == ']' || c == '}')
+			{
+				depth--;
+			}
+			if (c == ',' && depth == 0)
+			{
+				parts.push_back(trim(current));
+				current.clear();
+			}
+			else
+			{
+				current += c;
+			}
+		}
+		parts.push_back(trim(current));
+		return parts;
+	}
+
+	size_t splitArguments(size_t open, std::vector<std::string> &args) const
+	{
+		int depth = 0;
+		size_t pos = open;
+		for (; pos < m_text.size(); pos++)
+		{
+			char c = m_text[pos];
+			if (c == '(')
+			{
+				depth++;
+			}
+			else if (c == ')' && --depth == 0)
+			{
+				break;
+			}
+		}
+		args = splitTopLevel(m_text.substr(open + 1, pos - open - 1));
+		return pos + 1;
+	}
+
+	static std::string join(const std::vector<std::string> &parts, size_t from)
+	{
+		std::string result;
+		for (size_t i = from; i < parts.size(); i++)
+		{
+			result += (i == from ? "" : ", ") + parts[i];
+		}
+		return result;
+	}
+
+	/**
+	 * @brief 将 JSON_PROPERTY 系列宏还原为属性类型、名称与序列化器，与宏展开保持一致
+	 */
+	static bool addProperty(JsonGenClass &cls, const std::string &macro, const std::vector<std::string> &args, std::string &error)
+	{
+		// JSON_PROPERTY_WITH 之外的宏不允许类型中出现顶层逗号，参数个数与宏定义一致
+		JsonGenProperty property;
+		if (args.size() >= 2)
+		{
+			property.type = args[0];
+			property.name = args[1];
+		}
+		if (macro == "JSON_PROPERTY" && args.size() == 2)
+		{
+			property.codec = "Serializer<" + property.type + ">";
+		}
+		else if (macro == "JSON_PROPERTY_WITH" && args.size() >= 3)
+		{
+			property.codec = join(args, 2);
+		}
+		else if (macro == "JSON_PROPERTY_DECIMALS" && args.size() == 3)
+		{
+			property.codec = "JsonPrecisionSerializer<" + property.type + ", JsonFloatPrecision::Decimals, " + args[2] + ">";
+		}
+		else if (macro == "JSON_PROPERTY_SIGNIFICANT" && args.size() == 3)
+		{
+			property.codec = "JsonPrecisionSerializer<" + property.type + ", JsonFloatPrecision::SignificantDigits, " + args[2] + ">";
+		}
+		else if (macro == "JSON_PROPERTY_COLUMNAR" && args.size() == 2)
+		{
+			property.codec = "JsonColumnarSerializer<" + property.type + ">";
+		}
+		else if (macro == "JSON_PROPERTY_DELTA" && args.size() == 2)
+		{
+			property.codec = "JsonDeltaSerializer<" + property.type + ">";
+		}
+		else if (macro == "JSON_PROPERTY_ALIAS" && args.size() == 3)
+		{
+			property.codec = "Serializer<" + property.type + ">";
+			property.alias = args[2];
+		}
+		else
+		{
+			error = "unsupported declaration " + macro + " in " + cls.name;
+			return false;
+		}
+		cls.properties.push_back(property);
+		return true;
+	}
+
+	std::string m_text;
+	std::vector<JsonGenClass> m_classes;
+};
+
+/**
+ * @brief 代码生成器
+ * @details 键的分配与查找规则与 JsonPropertyTable 完全一致，生成代码与元对象路径输出相同的 JSON
+ */
+class JsonGenWriter
+{
+public:
+	JsonGenWriter(const std::vector<JsonGenClass> &classes, const std::string &header)
+		: m_classes(classes), m_header(header)
+	{
+	}
+
+	/**
+	 * @brief 生成源文件内容
+	 * @param result 生成的源文件内容
+	 * @param error 失败原因
+	 * @return bool 有类的基类无法确定时返回 false
+	 */
+	bool generate(std::string &result, std::string &error) const
+	{
+		std::ostringstream out;
+		out << "// File: " << generatedName(m_header) << "\n";
+		out << "// 由 JsonSerializerGen 根据 " << baseName(m_header) << " 生成，请勿手动修改\n";
+		out << "#include \"" << baseName(m_header) << "\"\n";
+
+		for (const JsonGenClass &cls : m_classes)
+		{
+			std::vector<JsonGenProperty> properties;
+			std::string unresolved;
+			if (!collect(cls, properties, unresolved))
+			{
+				// 本类未声明属性时不生成代码；否则漏掉基类的属性会让输出与元对象路径不一致，不能静默跳过
+				if (cls.properties.empty())
+				{
+					continue;
+				}
+				error = cls.name + ": base class " + unresolved + " is not declared in " + m_header;
+				return false;
+			}
+			if (!properties.empty())
+			{
+				assignAliases(cls.name, properties);
+				writeClass(out, cls.name, properties);
+			}
+		}
+		result = out.str();
+		return true;
+	}
+
+	static std::string generatedName(const std::string &header)
+	{
+		std::string name = baseName(header);
+		// 与 CMake 的 NAME_WE 一致，去掉第一个点之后的部分
+		return name.substr(0, name.find('.')) + ".json.cpp";
+	}
+
+private:
+	static std::string baseName(const std::string &path)
+	{
+		size_t slash = path.find_last_of("/\\");
+		return slash == std::string::npos ? path : path.substr(slash + 1);
+	}
+
+	static std::string lower(std::string text)
+	{
+		for (char &c : text)
+		{
+			c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+		}
+		return text;
+	}
+
+	const JsonGenClass *find(const std::string &name) const
+	{
+		for (const JsonGenClass &cls : m_classes)
+		{
+			size_t length = cls.name.size();
+			if (cls.name == name || (length > name.size() && cls.name.compare(length - name.size(), name.size(), name) == 0 &&
+									 cls.name.compare(length - name.size() - 2, 2, "::") == 0))
+			{
+				return &cls;
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief 是否为库提供的基类，这些基类不声明 JSON 属性
+	 */
+	static bool isLibraryBase(const std::string &base)
+	{
+		static const char *const bases[] = {"JsonSerializable", "JsonSerializableT", "JsonCachedSerializable"};
+		std::string name = base.substr(0, base.find('<'));
+		if (name.compare(0, 2, "::") == 0)
+		{
+			name.erase(0, 2);
+		}
+		return std::find(std::begin(bases), std::end(bases), name) != std::end(bases);
+	}
+
+	/**
+	 * @brief 按元对象的属性顺序收集属性：基类属性在前，本类属性在后
+	 * @param unresolved 无法确定的基类名
+	 * @return bool 基类的属性无法确定时返回 false
+	 */
+	bool collect(const JsonGenClass &cls, std::vector<JsonGenProperty> &properties, std::string &unresolved) const
+	{
+		for (const std::string &base : cls.bases)
+		{
+			if (isLibraryBase(base))
+			{
+				continue;
+			}
+			const JsonGenClass *known = find(base);
+			if (!known)
+			{
+				unresolved = base;
+				return false;
+			}
+			if (!collect(*known, properties, unresolved))
+			{
+				return false;
+			}
+		}
+		properties.insert(properties.end(), cls.properties.begin(), cls.properties.end());
+		return true;
+	}
+
+	static std::string autoAlias(int ordinal)
+	{
+		std::string alias;
+		do
+		{
+			alias.insert(alias.begin(), static_cast<char>('a' + ordinal % 26));
+			ordinal = ordinal / 26 - 1;
+		} while (ordinal >= 0);
+		return alias;
+	}
+
+	/**
+	 * @brief 为未显式声明短键名的属性分配短键名，跳过已被占用的键
+	 * @details 与 JsonPropertyTable 一致，与其他键冲突的显式短键名会被忽略并改为自动分配
+	 */
+	static void assignAliases(const std::string &className, std::vector<JsonGenProperty> &properties)
+	{
+		std::set<std::string> exact;
+		std::map<std::string, size_t> folded;
+		for (size_t i = 0; i < properties.size(); i++)
+		{
+			exact.insert(properties[i].name);
+			folded.emplace(lower(properties[i].name), i);
+		}
+		for (size_t i = 0; i < properties.size(); i++)
+		{
+			JsonGenProperty &property = properties[i];
+			if (property.alias.empty())
+			{
+				continue;
+			}
+			auto owner = folded.find(lower(property.alias));
+			if (owner != folded.end() && owner->second != i)
+			{
+				std::cerr << "JsonSerializerGen: alias \"" << property.alias << "\" of " << className << "::" << property.name
+						  << " collides with another key and is ignored\n";
+				property.alias.clear();
+				continue;
+			}
+			exact.insert(property.alias);
+			folded.emplace(lower(property.alias), i);
+		}
+		int ordinal = 0;
+		for (size_t i = 0; i < properties.size(); i++)
+		{
+			JsonGenProperty &property = properties[i];
+			if (property.alias.empty())
+			{
+				do
+				{
+					property.alias = autoAlias(ordinal++);
+				} while (exact.count(property.alias) || folded.count(lower(property.alias)));
+				property.autoAlias = true;
+				exact.insert(property.alias);
+				folded.emplace(lower(property.alias), i);
+			}
+		}
+	}
+
+	/**
+	 * @brief 生成键查找函数：先按长度分派，同长度内先精确匹配再不区分大小写匹配
+	 * @details 与 JsonPropertyTable::indexOf() 一致，自动短键名只在 JsonCompactKeysScope 中匹配
+	 */
+	static void writeIndexOf(std::ostringstream &out, const std::vector<JsonGenProperty> &properties)
+	{
+		// 键的登记顺序：完整键名、显式短键名、自动短键名，同名时先登记者优先
+		struct Key
+		{
+			std::string text;
+			size_t index;
+			bool compactOnly;
+		};
+		std::vector<Key> keys;
+		for (size_t i = 0; i < properties.size(); i++)
+		{
+			keys.push_back({properties[i].name, i, false});
+		}
+		for (size_t i = 0; i < properties.size(); i++)
+		{
+			if (!properties[i].autoAlias)
+			{
+				keys.push_back({properties[i].alias, i, false});
+			}
+		}
+		for (size_t i = 0; i < properties.size(); i++)
+		{
+			if (properties[i].autoAlias)
+			{
+				keys.push_back({properties[i].alias, i, true});
+			}
+		}
+		std::map<size_t, std::vector<Key>> byLength;
+		for (const Key &key : keys)
+		{
+			byLength[key.text.size()].push_back(key);
+		}
+
+		out << "\tstatic int indexOf(const QString &key)\n";
+		out << "\t{\n";
+		out << "\t\tswitch (key.size())\n";
+		out << "\t\t{\n";
+		for (const auto &group : byLength)
+		{
+			out << "\t\tcase " << group.first << ":\n";
+			for (const Key &key : group.second)
+			{
+				out << "\t\t\tif (key == QLatin1String(\"" << key.text << "\")" << (key.compactOnly ? " && JsonCompactKeysScope::active()" : "") << ")\n";
+				out << "\t\t\t{\n\t\t\t\treturn " << key.index << ";\n\t\t\t}\n";
+			}
+			for (const Key &key : group.second)
+			{
+				out << "\t\t\tif (key.compare(QLatin1String(\"" << key.text << "\"), Qt::CaseInsensitive) == 0" << (key.compactOnly ? " && JsonCompactKeysScope::active()" : "") << ")\n";
+				out << "\t\t\t{\n\t\t\t\treturn " << key.index << ";\n\t\t\t}\n";
+			}
+			out << "\t\t\tbreak;\n";
+		}
+		out << "\t\tdefault:\n";
+		out << "\t\t\tbreak;\n";
+		out << "\t\t}\n";
+		out << "\t\treturn -1;\n";
+		out << "\t}\n";
+	}
+
+	static void writeClass(std::ostringstream &out, const std::string &name, const std::vector<JsonGenProperty> &properties)
+	{
+		out << "\n/**\n";
+		out << " * @brief " << name << " 的生成序列化代码\n";
+		out << " */\n";
+		out << "template <>\n";
+		out << "struct JsonGeneratedCodec<" << name << ">\n";
+		out << "{\n";
+		out << "\tstatic QJsonObject toJson(const " << name << " &value)\n";
+		out << "\t{\n";
+		out << "\t\tconst bool compact = JsonCompactKeysScope::active();\n";
+		out << "\t\tQJsonObject json;\n";
+		for (const JsonGenProperty &property : properties)
+		{
+			out << "\t\tjson.insert(compact ? QStringLiteral(\"" << property.alias << "\") : QStringLiteral(\"" << property.name << "\"), "
+				<< property.codec << "::toJson(value.ref_" << property.name << "()));\n";
+		}
+		out << "\t\treturn json;\n";
+		out << "\t}\n\n";
+
+		out << "\tstatic void fromJson(" << name << " &value, const QJsonValue &val)\n";
+		out << "\t{\n";
+		out << "\t\tif (!val.isObject())\n";
+		out << "\t\t{\n\t\t\treturn;\n\t\t}\n";
+		out << "\t\tQJsonObject json = val.toObject();\n";
+		out << "\t\tfor (auto it = json.constBegin(); it != json.constEnd(); ++it)\n";
+		out << "\t\t{\n";
+		out << "\t\t\tswitch (indexOf(it.key()))\n";
+		out << "\t\t\t{\n";
+		for (size_t i = 0; i < properties.size(); i++)
+		{
+			out << "\t\t\tcase " << i << ":\n";
+			out << "\t\t\t\tvalue.set_" << properties[i].name << "(" << properties[i].codec << "::fromJson(it.value()));\n";
+			out << "\t\t\t\tbreak;\n";
+		}
+		out << "\t\t\tdefault:\n";
+		out << "\t\t\t\tbreak;\n";
+		out << "\t\t\t}\n";
+		out << "\t\t}\n";
+		out << "\t}\n\n";
+		writeIndexOf(out, properties);
+		out << "};\n\n";
+
+		out << "JSON_REGISTER_GENERATED(" << name << ")\n";
+	}
+
+	const std::vector<JsonGenClass> &m_classes;
+	std::string m_header;
+};
+
+int main(int argc, char *argv[])
+{
+	if (argc != 3)
+	{
+		std::cerr << "usage: JsonSerializerGen <input header> <output source>\n";
+		return 2;
+	}
+
+	std::ifstream input(argv[1], std::ios::binary);
+	if (!input)
+	{
+		std::cerr << "JsonSerializerGen: cannot open " << argv[1] << "\n";
+		return 1;
+	}
+	std::stringstream buffer;
+	buffer << input.rdbuf();
+
+	JsonGenScanner scanner(buffer.str());
+	std::string error;
+	if (!scanner.scan(error))
+	{
+		std::cerr << argv[1] << ": " << error << "\n";
+		return 1;
+	}
+
+	std::string generated;
+	if (!JsonGenWriter(scanner.classes(), argv[1]).generate(generated, error))
+	{
+		std::cerr << argv[1] << ": " << error << "\n";
+		return 1;
+	}
+
+	std::ofstream output(argv[2], std::ios::binary | std::ios::trunc);
+	if (!output || !(output << generated))
+	{
+		std::cerr << "JsonSerializerGen: cannot write " << argv[2] << "\n";
+		return 1;
+	}
+	return 0;
+}